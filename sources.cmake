@@ -6,6 +6,8 @@ dplx_target_sources(deeppack
 
     PUBLIC
         dp
+        dp/sequence_index
+        dp/value
 
         dp/codecs/core
         dp/codecs/fixed_u8string
@@ -15,10 +17,20 @@ dplx_target_sources(deeppack
         dp/codecs/system_error2
         dp/codecs/uuid
 
+        dp/detail/utf8
+
         dp/items/copy_item
+        dp/items/item_push_parser
+        dp/items/item_ref
+        dp/items/item_tape
         dp/items/skip_item
 
+        dp/streams/allocators
+        dp/streams/buffer_pool
         dp/streams/dynamic_memory_output_stream
+        dp/streams/gather_output_stream
+        dp/streams/segmented_input_stream
+        dp/streams/segmented_output_stream
 )
 
 dplx_target_sources(deeppack
@@ -28,20 +40,24 @@ dplx_target_sources(deeppack
 
     PUBLIC
         dp/api
+        dp/async
         dp/concepts
         dp/config
         dp/disappointment
         dp/fwd
+        dp/incremental_decoder
         dp/indefinite_range
         dp/layout_descriptor
         dp/macros
         dp/object_def
+        dp/sequence
         dp/state
         dp/tuple_def
 
         dp/codecs/auto_enum
         dp/codecs/auto_object
         dp/codecs/auto_tuple
+        dp/codecs/embedded_cbor
         dp/codecs/std-container
         dp/codecs/std-tuple
 
@@ -67,6 +83,7 @@ dplx_target_sources(deeppack
         dp/items/parse_context
         dp/items/parse_core
         dp/items/parse_ranges
+        dp/items/typed_array
         dp/items/type_code
 
         dp/streams/input_buffer
@@ -82,6 +99,22 @@ dplx_target_sources(deeppack
         dp/legacy/memory_output_stream
 )
 
+if (UNIX)
+    dplx_target_sources(deeppack
+        TEST_TARGET deeppack-tests
+        MODE SMART_SOURCE MERGED_LAYOUT
+        BASE_DIR dplx
+
+        PUBLIC
+            dp/detail/posix_file
+
+            dp/streams/async_file_output_stream
+            dp/streams/file_output_stream
+            dp/streams/mapped_file_input_stream
+            dp/streams/prefetching_file_input_stream
+    )
+endif ()
+
 file(MAKE_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/generated/src/dplx/dp/detail")
 configure_file(tools/config.hpp.in "${CMAKE_CURRENT_BINARY_DIR}/generated/src/dplx/dp/detail/config.hpp" @ONLY)
 target_sources(deeppack PUBLIC $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}/generated/src/dplx/dp/detail/config.hpp>)
@@ -99,6 +132,7 @@ if (BUILD_TESTING)
             item_sample_rt.hpp
             range_generator.hpp
             simple_encodable.hpp
+            temporary_file.hpp
             test_input_stream.hpp
             test_output_stream.hpp
             test_utils.hpp
@@ -0,0 +1,81 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace dp_tests
+{
+
+/**
+ * Reserves a unique path within the temporary directory and removes the
+ * file (if any) on destruction.
+ */
+class temporary_file
+{
+    std::filesystem::path mPath;
+
+public:
+    ~temporary_file() noexcept
+    {
+        std::error_code ec;
+        std::filesystem::remove(mPath, ec);
+    }
+    temporary_file()
+        : mPath(std::filesystem::temp_directory_path() / unique_name())
+    {
+    }
+    explicit temporary_file(std::span<std::byte const> const content)
+        : temporary_file()
+    {
+        std::ofstream file(mPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const *>(content.data()),
+                   static_cast<std::streamsize>(content.size()));
+    }
+
+    temporary_file(temporary_file const &) = delete;
+    auto operator=(temporary_file const &) -> temporary_file & = delete;
+
+    [[nodiscard]] auto path() const noexcept -> std::filesystem::path const &
+    {
+        return mPath;
+    }
+
+    [[nodiscard]] auto content() const -> std::vector<std::byte>
+    {
+        std::ifstream file(mPath, std::ios::binary);
+        std::vector<char> raw{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+        std::vector<std::byte> bytes(raw.size());
+        if (!raw.empty())
+        {
+            std::memcpy(bytes.data(), raw.data(), raw.size());
+        }
+        return bytes;
+    }
+
+private:
+    static auto unique_name() -> std::string
+    {
+        static std::atomic<unsigned> counter{0U};
+        static unsigned const seed = std::random_device{}();
+        return "deeppack-test-" + std::to_string(seed) + "-"
+               + std::to_string(counter.fetch_add(1U)) + ".tmp";
+    }
+};
+
+} // namespace dp_tests
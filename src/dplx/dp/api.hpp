@@ -7,6 +7,14 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
 #include <dplx/cncr/type_utils.hpp>
 
 #include <dplx/dp/concepts.hpp>
@@ -16,6 +24,7 @@
 #include <dplx/dp/items/emit_context.hpp>
 #include <dplx/dp/items/parse_context.hpp>
 #include <dplx/dp/streams/input_buffer.hpp>
+#include <dplx/dp/streams/memory_output_stream.hpp>
 #include <dplx/dp/streams/output_buffer.hpp>
 #include <dplx/dp/streams/void_stream.hpp>
 
@@ -57,6 +66,42 @@ inline constexpr struct encoded_size_of_fn
     }
 } encoded_size_of{};
 
+// computes the encoded size like encoded_size_of(), but memoizes it in the
+// size_cache of the context (if any). Codecs which need the size of a
+// subitem in size_of() and encode() must query it with this function in the
+// same order and for the same object during both passes, otherwise the
+// cache is disabled and the sizes are recomputed.
+inline constexpr struct memoized_size_of_fn
+{
+    template <typename T>
+        requires encodable<cncr::remove_cref_t<T>>
+    constexpr auto operator()(emit_context &ctx, T &&value) const noexcept
+            -> std::uint64_t
+    {
+        using unqualified_type = cncr::remove_cref_t<T>;
+        auto const &v = static_cast<unqualified_type const &>(value);
+
+        size_cache *const sizes = ctx.sizes;
+        if (sizes == nullptr)
+        {
+            return codec<unqualified_type>::size_of(ctx, v);
+        }
+        if (sizes->replaying())
+        {
+            std::uint64_t size = 0U;
+            if (!sizes->next(&v, size)) [[unlikely]]
+            {
+                size = codec<unqualified_type>::size_of(ctx, v);
+            }
+            return size;
+        }
+        auto const slot = sizes->reserve(&v);
+        std::uint64_t const size = codec<unqualified_type>::size_of(ctx, v);
+        sizes->assign(slot, size);
+        return size;
+    }
+} memoized_size_of{};
+
 // the encode APIs are not meant to participate in ADL and are therefore
 // niebloids
 inline constexpr struct encode_fn final
@@ -92,6 +137,72 @@ inline constexpr struct encode_fn final
     }
 } encode{};
 
+// encodes into a caller provided buffer and returns the written prefix;
+// fails with errc::end_of_stream if the buffer is too small
+inline constexpr struct encode_to_buffer_fn final
+{
+    template <typename T>
+        requires encodable<cncr::remove_cref_t<T>>
+    inline auto operator()(std::span<std::byte> buffer,
+                           T &&value) const noexcept
+            -> result<std::span<std::byte>>
+    {
+        memory_output_stream outStream(buffer);
+        emit_context ctx{outStream};
+        DPLX_TRY(codec<cncr::remove_cref_t<T>>::encode(
+                ctx, static_cast<cncr::remove_cref_t<T> const &>(value)));
+        return outStream.written();
+    }
+} encode_to_buffer{};
+
+// computes the encoded size upfront and allocates exactly once, i.e. the
+// codecs never hit the output_buffer::do_grow() slow path
+inline constexpr struct encode_to_vector_fn final
+{
+    template <typename T>
+        requires encodable<cncr::remove_cref_t<T>>
+    inline auto operator()(T &&value) const noexcept
+            -> result<std::vector<std::byte>>
+    {
+        return (*this)(static_cast<T &&>(value), std::allocator<std::byte>{});
+    }
+    template <typename T, typename Allocator>
+        requires encodable<cncr::remove_cref_t<T>>
+                 && std::same_as<typename Allocator::value_type, std::byte>
+    inline auto operator()(T &&value, Allocator const &alloc) const noexcept
+            -> result<std::vector<std::byte, Allocator>>
+    {
+        using unqualified_type = cncr::remove_cref_t<T>;
+        auto const &v = static_cast<unqualified_type const &>(value);
+
+        // the sizes memoized by the size_of() pass are replayed by encode()
+        size_cache sizes;
+        void_stream dummyStream{};
+        emit_context sizeCtx{dummyStream, &sizes};
+
+        std::vector<std::byte, Allocator> buffer(alloc);
+        try
+        {
+            buffer.resize(static_cast<std::size_t>(
+                    codec<unqualified_type>::size_of(sizeCtx, v)));
+        }
+        catch (std::bad_alloc const &)
+        {
+            return errc::not_enough_memory;
+        }
+
+        sizes.start_replay();
+        memory_output_stream outStream(buffer);
+        emit_context ctx{outStream, &sizes};
+        DPLX_TRY(codec<unqualified_type>::encode(ctx, v));
+        // size_of() and encode() of the codec disagree
+        assert(outStream.written().size() == buffer.size());
+        // encode() didn't query every memoized size in order
+        assert(sizes.replay_complete());
+        return buffer;
+    }
+} encode_to_vector{};
+
 // the decode APIs are not meant to participate in ADL and are therefore
 // niebloids
 inline constexpr struct decode_fn final
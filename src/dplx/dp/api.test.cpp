@@ -1,4 +1,3 @@
-
 // Copyright Henrik Steffen Gaßmann 2020
 //
 // Distributed under the Boost Software License, Version 1.0.
@@ -7,11 +6,165 @@
 
 #include "dplx/dp/api.hpp"
 
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include "blob_matcher.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/embedded_cbor.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/items/emit_core.hpp"
+#include "dplx/dp/items/item_size_of_core.hpp"
+#include "dplx/dp/streams/allocators.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
 #include "test_utils.hpp"
 
 namespace dp_tests
 {
-// TODO: Add tests for public API niebloids
+
+namespace
+{
+
+struct size_counted
+{
+    int value;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    static inline int numSizeOfCalls = 0;
+};
+
+} // namespace
+
+} // namespace dp_tests
+
+template <>
+class dplx::dp::codec<dp_tests::size_counted>
+{
+public:
+    static auto size_of(emit_context &ctx, dp_tests::size_counted c) noexcept
+            -> std::uint64_t
+    {
+        ++dp_tests::size_counted::numSizeOfCalls;
+        return dp::item_size_of_integer(ctx, c.value);
+    }
+    static auto encode(emit_context &ctx, dp_tests::size_counted c) noexcept
+            -> result<void>
+    {
+        return dp::emit_integer(ctx, c.value);
+    }
+};
+
+namespace dp_tests
+{
+
+TEST_CASE("encode_to_vector should allocate the exact size")
+{
+    std::vector<int> values(1000U);
+    std::iota(values.begin(), values.end(), -500);
+
+    dp::dynamic_memory_output_stream<> expected;
+    REQUIRE(dp::encode(expected, values));
+
+    auto encodeRx = dp::encode_to_vector(values);
+    REQUIRE(encodeRx);
+    CHECK(encodeRx.assume_value().size() == expected.written_size());
+    CHECK_BLOB_EQ(encodeRx.assume_value(), expected.written());
+
+    SECTION("with a custom allocator")
+    {
+        auto allocRx = dp::encode_to_vector(
+                values, dp::default_init_allocator<std::byte>{});
+        REQUIRE(allocRx);
+        CHECK_BLOB_EQ(allocRx.assume_value(), expected.written());
+    }
+}
+
+TEST_CASE("encode_to_vector should compute nested sizes only once")
+{
+    size_counted const item{0x1'0000};
+    // CTAD would copy instead of nesting the wrappers
+    dp::as_embedded_cbor<size_counted const> const inner{item};
+    dp::as_embedded_cbor<decltype(inner)> const middle{inner};
+    dp::as_embedded_cbor<decltype(middle)> const value{middle};
+
+    size_counted::numSizeOfCalls = 0;
+    dp::dynamic_memory_output_stream<> expected;
+    REQUIRE(dp::encode(expected, value));
+    // once per enclosing byte string
+    CHECK(size_counted::numSizeOfCalls == 3);
+
+    size_counted::numSizeOfCalls = 0;
+    auto encodeRx = dp::encode_to_vector(value);
+    REQUIRE(encodeRx);
+    CHECK(size_counted::numSizeOfCalls == 1);
+    CHECK_BLOB_EQ(encodeRx.assume_value(), expected.written());
+}
+
+TEST_CASE("memoized_size_of should replay the recorded sizes")
+{
+    dp::size_cache sizes;
+    dp::void_stream dummyStream{};
+    dp::emit_context ctx{dummyStream, &sizes};
+
+    size_counted const first{24};
+    size_counted const second{1};
+
+    size_counted::numSizeOfCalls = 0;
+    CHECK(dp::memoized_size_of(ctx, first) == 2U);
+    CHECK(dp::memoized_size_of(ctx, second) == 1U);
+    CHECK(sizes.size() == 2U);
+
+    sizes.start_replay();
+    SECTION("in order")
+    {
+        CHECK(dp::memoized_size_of(ctx, first) == 2U);
+        CHECK(dp::memoized_size_of(ctx, second) == 1U);
+        CHECK(size_counted::numSizeOfCalls == 2);
+        CHECK(sizes.replay_complete());
+
+        SECTION("and fall back to size_of() once exhausted")
+        {
+            size_counted const third{0x1'0000};
+            CHECK(dp::memoized_size_of(ctx, third) == 5U);
+            CHECK(size_counted::numSizeOfCalls == 3);
+        }
+    }
+    SECTION("and detect a diverging order")
+    {
+        CHECK(dp::memoized_size_of(ctx, second) == 1U);
+        CHECK(size_counted::numSizeOfCalls == 3);
+        CHECK_FALSE(sizes.valid());
+        CHECK(dp::memoized_size_of(ctx, first) == 2U);
+        CHECK(size_counted::numSizeOfCalls == 4);
+    }
+    SECTION("and detect unconsumed sizes")
+    {
+        CHECK(dp::memoized_size_of(ctx, first) == 2U);
+        CHECK_FALSE(sizes.replay_complete());
+    }
+}
+
+TEST_CASE("encode_to_buffer should return the written prefix")
+{
+    std::array<std::byte, 16U> buffer{};
+
+    auto encodeRx = dp::encode_to_buffer(buffer, 0x1'0000);
+    REQUIRE(encodeRx);
+    CHECK(encodeRx.assume_value().data() == buffer.data());
+    std::array const expected{std::byte{0x1a}, std::byte{0x00},
+                              std::byte{0x01}, std::byte{0x00},
+                              std::byte{0x00}};
+    CHECK_BLOB_EQ(encodeRx.assume_value(), expected);
+
+    SECTION("and fail if the buffer is too small")
+    {
+        auto tooLargeRx
+                = dp::encode_to_buffer(buffer, std::vector<int>(buffer.size()));
+        CHECK(tooLargeRx.error() == dp::errc::end_of_stream);
+    }
 }
+
+} // namespace dp_tests
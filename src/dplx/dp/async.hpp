@@ -0,0 +1,297 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dplx/dp/api.hpp>
+#include <dplx/dp/concepts.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/incremental_decoder.hpp>
+#include <dplx/dp/items/item_push_parser.hpp>
+
+// coroutine adapters which suspend while waiting for the caller supplied
+// read/write awaitables instead of blocking inside a stream hook
+
+namespace dplx::dp
+{
+
+/**
+ * A lazily started coroutine which completes with a `result<T>`. The
+ * awaiting coroutine is resumed by symmetric transfer, i.e. chains of tasks
+ * don't grow the stack. A failed coroutine frame allocation is reported as
+ * `errc::not_enough_memory`.
+ */
+template <typename T>
+class task
+{
+public:
+    class promise_type;
+
+private:
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct final_awaiter
+    {
+        static auto await_ready() noexcept -> bool
+        {
+            return false;
+        }
+        static auto await_suspend(handle_type const self) noexcept
+                -> std::coroutine_handle<>
+        {
+            auto const continuation = self.promise().mContinuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        static void await_resume() noexcept
+        {
+        }
+    };
+
+public:
+    class promise_type
+    {
+        friend class task;
+
+        std::coroutine_handle<> mContinuation{};
+        std::optional<result<T>> mResult{};
+
+    public:
+        auto get_return_object() noexcept -> task
+        {
+            return task(handle_type::from_promise(*this));
+        }
+        static auto get_return_object_on_allocation_failure() noexcept
+                -> task
+        {
+            return task(nullptr);
+        }
+
+        static auto initial_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+        static auto final_suspend() noexcept -> final_awaiter
+        {
+            return {};
+        }
+
+        void return_value(result<T> &&value) noexcept
+        {
+            mResult.emplace(static_cast<result<T> &&>(value));
+        }
+        [[noreturn]] static void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+
+private:
+    handle_type mHandle;
+
+    explicit task(handle_type const handle) noexcept
+        : mHandle(handle)
+    {
+    }
+
+public:
+    ~task()
+    {
+        if (mHandle)
+        {
+            mHandle.destroy();
+        }
+    }
+    task(task const &) = delete;
+    auto operator=(task const &) -> task & = delete;
+    task(task &&other) noexcept
+        : mHandle(std::exchange(other.mHandle, nullptr))
+    {
+    }
+    auto operator=(task &&other) noexcept -> task &
+    {
+        if (this != &other)
+        {
+            if (mHandle)
+            {
+                mHandle.destroy();
+            }
+            mHandle = std::exchange(other.mHandle, nullptr);
+        }
+        return *this;
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            handle_type mHandle;
+
+            [[nodiscard]] auto await_ready() const noexcept -> bool
+            {
+                return !mHandle;
+            }
+            auto await_suspend(std::coroutine_handle<> const awaiting) noexcept
+                    -> std::coroutine_handle<>
+            {
+                mHandle.promise().mContinuation = awaiting;
+                return mHandle;
+            }
+            auto await_resume() noexcept -> result<T>
+            {
+                if (!mHandle) [[unlikely]]
+                {
+                    return errc::not_enough_memory;
+                }
+                return static_cast<result<T> &&>(*mHandle.promise().mResult);
+            }
+        };
+        return awaiter{mHandle};
+    }
+};
+
+/**
+ * Buffers the chunks produced by a caller supplied `readSome` function
+ * object. `readSome(std::span<std::byte>)` must return an awaitable which
+ * fills a prefix of the span and yields its size as `result<std::size_t>`;
+ * a size of zero denotes the end of input. The bytes of a chunk which
+ * haven't been consumed by the previous `async_decode()` are kept for the
+ * next one.
+ */
+template <typename ReadSome>
+class async_input
+{
+    ReadSome mReadSome;
+    std::span<std::byte> mBuffer;
+    std::span<std::byte const> mPending;
+
+public:
+    async_input(ReadSome readSome, std::span<std::byte> const buffer) noexcept(
+            std::is_nothrow_move_constructible_v<ReadSome>)
+        : mReadSome(static_cast<ReadSome &&>(readSome))
+        , mBuffer(buffer)
+        , mPending()
+    {
+    }
+
+    /**
+     * The bytes which have been read but not yet consumed.
+     */
+    [[nodiscard]] auto buffered() const noexcept -> std::span<std::byte const>
+    {
+        return mPending;
+    }
+    void consume(std::size_t const amount) noexcept
+    {
+        mPending = mPending.subspan(amount);
+    }
+
+    /**
+     * Replaces the buffered bytes with the next chunk; fails with
+     * `errc::end_of_stream` after the end of input.
+     */
+    auto fill() noexcept -> task<void>
+    {
+        result<std::size_t> readRx = co_await mReadSome(mBuffer);
+        if (readRx.has_failure())
+        {
+            co_return static_cast<result<std::size_t> &&>(readRx).as_failure();
+        }
+        if (readRx.assume_value() == 0U)
+        {
+            co_return errc::end_of_stream;
+        }
+        mPending = mBuffer.first(readRx.assume_value());
+        co_return outcome::success();
+    }
+};
+
+/**
+ * Decodes the next item from `input` into `outValue` and suspends whenever
+ * more input is required. Items spanning several chunks are accumulated by
+ * an `incremental_decoder`. The arguments are referenced by the returned
+ * task, i.e. they must outlive it.
+ */
+template <typename T, typename ReadSome>
+    requires decodable<T>
+inline auto async_decode(async_input<ReadSome> &input, T &outValue) noexcept
+        -> task<void>
+{
+    incremental_decoder<T> decoder;
+    for (;;)
+    {
+        if (input.buffered().empty())
+        {
+            result<void> fillRx = co_await input.fill();
+            if (fillRx.has_failure())
+            {
+                co_return static_cast<result<void> &&>(fillRx);
+            }
+        }
+        result<push_parse_result> feedRx
+                = decoder.feed(input.buffered(), outValue);
+        if (feedRx.has_failure())
+        {
+            co_return static_cast<result<push_parse_result> &&>(feedRx)
+                    .as_failure();
+        }
+        input.consume(feedRx.assume_value().consumed);
+        if (feedRx.assume_value().status == push_parse_status::item_complete)
+        {
+            co_return outcome::success();
+        }
+    }
+}
+
+/**
+ * Decodes the next item from `input` as a value, e.g.
+ * `auto messageRx = co_await dp::async_decode<message_type>(input);`
+ */
+template <typename T, typename ReadSome>
+    requires decodable<T> && std::default_initializable<T>
+inline auto async_decode(async_input<ReadSome> &input) noexcept -> task<T>
+{
+    T value{};
+    result<void> decodeRx = co_await dp::async_decode(input, value);
+    if (decodeRx.has_failure())
+    {
+        co_return static_cast<result<void> &&>(decodeRx).as_failure();
+    }
+    co_return static_cast<T &&>(value);
+}
+
+/**
+ * Encodes `value` into a single exactly sized buffer and hands it to the
+ * caller supplied `writeAll` function object which must return an awaitable
+ * yielding `result<void>` for a `std::span<std::byte const>`. The arguments
+ * are referenced by the returned task, i.e. they must outlive it.
+ */
+template <typename T, typename WriteAll>
+    requires encodable<T>
+inline auto async_encode(WriteAll &writeAll, T const &value) noexcept
+        -> task<void>
+{
+    result<std::vector<std::byte>> encodeRx = dp::encode_to_vector(value);
+    if (encodeRx.has_failure())
+    {
+        co_return static_cast<result<std::vector<std::byte>> &&>(encodeRx)
+                .as_failure();
+    }
+    std::span<std::byte const> const encoded = encodeRx.assume_value();
+    co_return co_await writeAll(encoded);
+}
+
+} // namespace dplx::dp
@@ -0,0 +1,196 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/async.hpp"
+
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+namespace
+{
+
+// resumes the suspended coroutines one after another, i.e. every read or
+// write suspends the awaiting coroutine like a non-blocking socket would
+struct test_scheduler
+{
+    std::deque<std::coroutine_handle<>> ready;
+
+    void run()
+    {
+        while (!ready.empty())
+        {
+            auto next = ready.front();
+            ready.pop_front();
+            next.resume();
+        }
+    }
+};
+
+struct suspend_on
+{
+    test_scheduler &scheduler;
+
+    static auto await_ready() noexcept -> bool
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> const awaiting) const
+    {
+        scheduler.ready.push_back(awaiting);
+    }
+    static void await_resume() noexcept
+    {
+    }
+};
+
+struct chunked_reader
+{
+    test_scheduler *scheduler;
+    std::span<std::byte const> *input;
+    std::size_t chunkSize;
+    int *reads;
+
+    auto operator()(std::span<std::byte> const buffer) const
+            -> dp::task<std::size_t>
+    {
+        co_await suspend_on{*scheduler};
+        ++*reads;
+        auto const size = std::min({chunkSize, buffer.size(), input->size()});
+        std::ranges::copy(input->first(size), buffer.begin());
+        *input = input->subspan(size);
+        co_return size;
+    }
+};
+
+struct collecting_writer
+{
+    test_scheduler &scheduler;
+    std::vector<std::byte> written;
+
+    auto operator()(std::span<std::byte const> const bytes)
+            -> dp::task<void>
+    {
+        co_await suspend_on{scheduler};
+        written.insert(written.end(), bytes.begin(), bytes.end());
+        co_return dp::success();
+    }
+};
+
+// drives a task from a non-coroutine context
+struct detached
+{
+    struct promise_type
+    {
+        static auto get_return_object() noexcept -> detached
+        {
+            return {};
+        }
+        static auto initial_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+        static auto final_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+        static void return_void() noexcept
+        {
+        }
+        [[noreturn]] static void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+} // namespace
+
+TEST_CASE("async_decode should suspend until an item has been received")
+{
+    std::vector<std::vector<int>> messages{
+            {}, {1, 2, 3}, std::vector<int>(200U)};
+    std::iota(messages[2].begin(), messages[2].end(), 1000);
+
+    dp::dynamic_memory_output_stream<> out;
+    for (auto const &message : messages)
+    {
+        REQUIRE(dp::encode(out, message));
+    }
+
+    auto const chunkSize = GENERATE(1U, 16U, 4096U);
+    INFO(chunkSize);
+
+    test_scheduler scheduler;
+    std::span<std::byte const> input = out.written();
+    int reads = 0;
+    std::array<std::byte, 64U> buffer{};
+    dp::async_input in(chunked_reader{&scheduler, &input, chunkSize, &reads},
+                       std::span<std::byte>(buffer));
+
+    std::vector<std::vector<int>> decoded;
+    dp::result<void> endRx = dp::success();
+    [](auto &in, auto &decoded, auto &endRx) -> detached
+    {
+        for (;;)
+        {
+            auto decodeRx = co_await dp::async_decode<std::vector<int>>(in);
+            if (decodeRx.has_failure())
+            {
+                endRx = decodeRx.as_failure();
+                co_return;
+            }
+            decoded.push_back(std::move(decodeRx).assume_value());
+        }
+    }(in, decoded, endRx);
+
+    CHECK(decoded.empty());
+    scheduler.run();
+
+    CHECK(decoded == messages);
+    CHECK(endRx.error() == dp::errc::end_of_stream);
+    CHECK(reads > 1);
+}
+
+TEST_CASE("async_encode should hand the encoded item to the writer")
+{
+    std::vector<int> const message{1, 2, 1000, -5};
+
+    test_scheduler scheduler;
+    collecting_writer writer{scheduler, {}};
+    dp::result<void> encodeRx = dp::errc::bad;
+    [](auto &writer, auto const &message, auto &encodeRx) -> detached
+    {
+        encodeRx = co_await dp::async_encode(writer, message);
+    }(writer, message, encodeRx);
+
+    CHECK(writer.written.empty());
+    scheduler.run();
+
+    REQUIRE(encodeRx);
+    auto expectedRx = dp::encode_to_vector(message);
+    REQUIRE(expectedRx);
+    CHECK(writer.written == expectedRx.assume_value());
+}
+
+} // namespace dp_tests
@@ -0,0 +1,115 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <dplx/dp/api.hpp>
+#include <dplx/dp/concepts.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/items/emit_context.hpp>
+#include <dplx/dp/items/emit_core.hpp>
+#include <dplx/dp/items/encoded_item_head_size.hpp>
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/items/type_code.hpp>
+
+// RFC 8949 section 3.4.5.1 encoded CBOR data items, i.e. tag 24 followed by
+// a byte string containing the encoded item. The byte string length is the
+// encoded size of the item which is memoized across the size_of() and
+// encode() passes, see `memoized_size_of()`.
+
+namespace dplx::dp
+{
+
+inline constexpr std::uint64_t embedded_cbor_tag = 24U;
+
+/**
+ * Encodes the referenced item as an embedded CBOR data item, e.g.
+ * `dp::encode(out, dp::as_embedded_cbor{v})`. Decoding requires a named
+ * wrapper, i.e. `dp::as_embedded_cbor wrapper{v};` followed by
+ * `dp::decode(in, wrapper)`.
+ */
+template <typename T>
+struct as_embedded_cbor
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    T &item;
+};
+
+template <typename T>
+as_embedded_cbor(T &) -> as_embedded_cbor<T>;
+
+template <typename T>
+class codec<as_embedded_cbor<T>>
+{
+    using item_type = std::remove_const_t<T>;
+
+public:
+    static auto size_of(emit_context &ctx,
+                        as_embedded_cbor<T> const &value) noexcept
+            -> std::uint64_t
+        requires encodable<item_type>
+    {
+        auto const itemSize = dp::memoized_size_of(ctx, value.item);
+        return dp::encoded_item_head_size<type_code::tag>(embedded_cbor_tag)
+             + dp::encoded_item_head_size<type_code::binary>(itemSize)
+             + itemSize;
+    }
+    static auto encode(emit_context &ctx,
+                       as_embedded_cbor<T> const &value) noexcept
+            -> result<void>
+        requires encodable<item_type>
+    {
+        DPLX_TRY(dp::emit_tag(ctx, embedded_cbor_tag));
+        DPLX_TRY(dp::emit_binary(ctx, dp::memoized_size_of(ctx, value.item)));
+        return dp::encode(ctx, value.item);
+    }
+    static auto decode(parse_context &ctx, as_embedded_cbor<T> &value) noexcept
+            -> result<void>
+        requires decodable<T>
+    {
+        DPLX_TRY(item_head const &tag, dp::parse_item_head(ctx));
+        if (tag.type != type_code::tag || tag.value != embedded_cbor_tag)
+        {
+            return errc::item_type_mismatch;
+        }
+        DPLX_TRY(item_head const &content, dp::parse_item_head(ctx));
+        if (content.type != type_code::binary)
+        {
+            return errc::item_type_mismatch;
+        }
+        if (content.indefinite())
+        {
+            return errc::indefinite_item;
+        }
+        if (ctx.in.input_size() < content.value)
+        {
+            return errc::missing_data;
+        }
+
+        // the item is decoded in place, i.e. borrowed views follow the rules
+        // of the outer input, and the amount of input it consumed must match
+        // the byte string length
+        auto const remainingAfter = ctx.in.input_size() - content.value;
+        DPLX_TRY(dp::decode(ctx, value.item));
+        if (ctx.in.input_size() > remainingAfter)
+        {
+            return errc::trailing_data;
+        }
+        if (ctx.in.input_size() < remainingAfter)
+        {
+            // the item exceeded its byte string
+            return errc::missing_data;
+        }
+        return outcome::success();
+    }
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,134 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/codecs/embedded_cbor.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <dplx/dp/api.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/codecs/std-string.hpp"
+#include "dplx/dp/streams/memory_input_stream.hpp"
+#include "dplx/dp/streams/segmented_input_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("as_embedded_cbor has a codec")
+{
+    std::vector<int> const value{1, 2, 0x1'0000};
+    // 24(h'8301021a00010000')
+    std::array const encoded{std::byte{0xd8}, std::byte{0x18},
+                             std::byte{0x48}, std::byte{0x83},
+                             std::byte{0x01}, std::byte{0x02},
+                             std::byte{0x1a}, std::byte{0x00},
+                             std::byte{0x01}, std::byte{0x00},
+                             std::byte{0x00}};
+
+    SECTION("with encode")
+    {
+        auto encodeRx = dp::encode_to_vector(dp::as_embedded_cbor{value});
+        REQUIRE(encodeRx);
+        CHECK_BLOB_EQ(encodeRx.assume_value(), encoded);
+    }
+    SECTION("with size_of")
+    {
+        CHECK(dp::encoded_size_of(dp::as_embedded_cbor{value})
+              == encoded.size());
+    }
+    SECTION("with decode")
+    {
+        std::vector<int> decoded;
+        dp::as_embedded_cbor wrapper{decoded};
+        REQUIRE(dp::decode(std::span<std::byte const>(encoded), wrapper));
+        CHECK(decoded == value);
+    }
+    SECTION("with decode of input which isn't resident")
+    {
+        std::array const segments{
+                std::span<std::byte const>(encoded).first(5U),
+                std::span<std::byte const>(encoded).subspan(5U)};
+        dp::segmented_input_stream in(segments);
+        dp::parse_context ctx{in};
+
+        std::vector<int> decoded;
+        dp::as_embedded_cbor wrapper{decoded};
+        REQUIRE(dp::decode(ctx, wrapper));
+        CHECK(decoded == value);
+    }
+}
+
+TEST_CASE("as_embedded_cbor should reject trailing bytes")
+{
+    // 24(h'0102')
+    std::array const encoded{std::byte{0xd8}, std::byte{0x18},
+                             std::byte{0x42}, std::byte{0x01},
+                             std::byte{0x02}};
+
+    int decoded = 0;
+    dp::as_embedded_cbor wrapper{decoded};
+    CHECK(dp::decode(std::span<std::byte const>(encoded), wrapper).error()
+          == dp::errc::trailing_data);
+}
+
+TEST_CASE("as_embedded_cbor should reject items exceeding the byte string")
+{
+    // 24(h'8201'), 2
+    std::array const encoded{std::byte{0xd8}, std::byte{0x18},
+                             std::byte{0x42}, std::byte{0x82},
+                             std::byte{0x01}, std::byte{0x02}};
+
+    std::vector<int> decoded;
+    dp::as_embedded_cbor wrapper{decoded};
+    CHECK(dp::decode(std::span<std::byte const>(encoded), wrapper).error()
+          == dp::errc::missing_data);
+}
+
+TEST_CASE("as_embedded_cbor should not borrow input which isn't resident")
+{
+    // 24(h'62616263'), i.e. 24(<<"abc">>)
+    std::array const encoded{std::byte{0xd8}, std::byte{0x18},
+                             std::byte{0x44}, std::byte{0x63},
+                             std::byte{0x61}, std::byte{0x62},
+                             std::byte{0x63}};
+    std::array const segments{
+            std::span<std::byte const>(encoded).first(5U),
+            std::span<std::byte const>(encoded).subspan(5U)};
+    dp::segmented_input_stream in(segments);
+    dp::parse_context ctx{in};
+
+    std::string_view decoded;
+    dp::as_embedded_cbor wrapper{decoded};
+
+    SECTION("without a borrow arena")
+    {
+        CHECK(dp::decode(ctx, wrapper).error()
+              == dp::errc::input_not_borrowable);
+    }
+    SECTION("but copy it into the borrow arena")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        ctx.borrow_arena = &arena;
+
+        REQUIRE(dp::decode(ctx, wrapper));
+        CHECK(decoded == "abc");
+        auto const *const first = static_cast<void const *>(decoded.data());
+        CHECK(first != static_cast<void const *>(encoded.data() + 4));
+    }
+}
+
+} // namespace dp_tests
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <ranges>
+#include <span>
 
 #include <dplx/predef/compiler/clang.h>
 
@@ -220,6 +221,15 @@ public:
         {
             return dp::emit_array_indefinite(ctx, vs, dp::encode);
         }
+        else if constexpr (std::ranges::contiguous_range<R>
+                           && std::ranges::sized_range<R>
+                           && arithmetic_array_element<
+                                   std::ranges::range_value_t<R>>)
+        {
+            return dp::emit_arithmetic_array(
+                    ctx, std::span<std::ranges::range_value_t<R> const>(
+                                 std::ranges::data(vs), std::ranges::size(vs)));
+        }
         else
         {
             return dp::emit_array(ctx, vs, dp::encode);
@@ -234,7 +244,19 @@ public:
 #endif
     {
         c.clear();
-        DPLX_TRY(dp::parse_array(ctx, c, decode_element));
+        if constexpr (integer_array_container<R>)
+        {
+            result<std::size_t> parseRx = dp::parse_integer_array(ctx, c);
+            if (parseRx.has_failure()) [[unlikely]]
+            {
+                c.clear();
+                return static_cast<decltype(parseRx) &&>(parseRx).as_failure();
+            }
+        }
+        else
+        {
+            DPLX_TRY(dp::parse_array(ctx, c, decode_element));
+        }
         return dp::success();
     }
     static auto decode(parse_context &ctx, R &c) noexcept -> result<void>
@@ -575,6 +597,23 @@ class codec<std::span<std::byte const, N>>
     : public detail::fixed_size_binary_item_container_codec<std::byte const>
 {
 };
+/**
+ * Decoding yields a view into the input buffer or into a copy owned by the
+ * borrow arena of the context, see `parse_binary_borrowed()`.
+ */
+template <>
+class codec<std::span<std::byte const>>
+    : public detail::fixed_size_binary_item_container_codec<std::byte const>
+{
+public:
+    static auto decode(parse_context &ctx,
+                       std::span<std::byte const> &value) noexcept
+            -> result<void>
+    {
+        DPLX_TRY(value, dp::parse_binary_borrowed(ctx));
+        return dp::success();
+    }
+};
 template <codable T, std::size_t N>
     requires range<std::span<T, N>>
 class codec<std::span<T, N>> : public detail::fixed_size_container_codec<T>
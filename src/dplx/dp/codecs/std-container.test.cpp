@@ -262,6 +262,17 @@ TEST_CASE("std::span of bytes has a codec")
 
         CHECK_BLOB_EQ(value, sampleValue);
     }
+    SECTION("with borrowing decode")
+    {
+        auto const encoded = sample.encoded_bytes();
+        simple_test_input_stream inputStream(encoded);
+
+        std::span<std::byte const> value;
+        REQUIRE(dp::decode(inputStream, value));
+
+        CHECK(value.data() == encoded.data() + 1);
+        CHECK_BLOB_EQ(value, sampleValue);
+    }
 }
 
 TEST_CASE("std::array of bytes has a codec")
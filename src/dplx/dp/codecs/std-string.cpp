@@ -27,6 +27,13 @@ auto codec<std::u8string_view>::encode(emit_context &ctx,
 {
     return dp::emit_u8string(ctx, value.data(), value.size());
 }
+auto codec<std::u8string_view>::decode(parse_context &ctx,
+                                       std::u8string_view &value) noexcept
+        -> result<void>
+{
+    DPLX_TRY(value, dp::parse_text_borrowed(ctx));
+    return outcome::success();
+}
 
 auto codec<std::u8string>::size_of(emit_context &ctx,
                                    std::u8string const &value) noexcept
@@ -60,6 +67,16 @@ auto codec<std::string_view>::encode(emit_context &ctx,
 {
     return dp::emit_u8string(ctx, value.data(), value.size());
 }
+auto codec<std::string_view>::decode(parse_context &ctx,
+                                     std::string_view &value) noexcept
+        -> result<void>
+{
+    DPLX_TRY(std::u8string_view const text, dp::parse_text_borrowed(ctx));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    value = std::string_view(reinterpret_cast<char const *>(text.data()),
+                             text.size());
+    return outcome::success();
+}
 
 auto codec<std::string>::size_of(emit_context &ctx,
                                  std::string const &value) noexcept
@@ -16,6 +16,10 @@
 namespace dplx::dp
 {
 
+/**
+ * Decoding yields a view into the input buffer or into a copy owned by the
+ * borrow arena of the context, see `parse_text_borrowed()`.
+ */
 template <>
 class codec<std::u8string_view>
 {
@@ -24,6 +28,8 @@ public:
             -> std::uint64_t;
     static auto encode(emit_context &ctx, std::u8string_view value) noexcept
             -> result<void>;
+    static auto decode(parse_context &ctx, std::u8string_view &value) noexcept
+            -> result<void>;
 };
 
 template <>
@@ -38,6 +44,10 @@ public:
             -> result<void>;
 };
 
+/**
+ * Decoding yields a view into the input buffer or into a copy owned by the
+ * borrow arena of the context, see `parse_text_borrowed()`.
+ */
 template <>
 class codec<std::string_view>
 {
@@ -46,6 +56,8 @@ public:
             -> std::uint64_t;
     static auto encode(emit_context &ctx, std::string_view value) noexcept
             -> result<void>;
+    static auto decode(parse_context &ctx, std::string_view &value) noexcept
+            -> result<void>;
 };
 
 template <>
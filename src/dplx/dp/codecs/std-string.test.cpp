@@ -12,6 +12,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <dplx/dp/api.hpp>
+#include <dplx/dp/streams/memory_input_stream.hpp>
 
 #include "blob_matcher.hpp"
 #include "item_sample_ct.hpp"
@@ -46,6 +47,19 @@ TEST_CASE("std::u8string_view should be encodable")
     {
         CHECK(dp::encoded_size_of(sample.value) == sample.encoded_length);
     }
+    SECTION("with borrowing decode support")
+    {
+        auto const encoded = sample.encoded_bytes();
+        dp::memory_input_stream inputStream(encoded);
+
+        std::u8string_view value;
+        REQUIRE(dp::decode(inputStream, value));
+
+        CHECK(value == sample.value);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        CHECK(reinterpret_cast<std::byte const *>(value.data())
+              == encoded.data() + 1);
+    }
 }
 
 TEST_CASE("std::u8string has a codec")
@@ -96,6 +110,15 @@ TEST_CASE("std::string_view should be encodable")
     {
         CHECK(dp::encoded_size_of(sample.value) == sample.encoded_length);
     }
+    SECTION("with borrowing decode support")
+    {
+        dp::memory_input_stream inputStream(sample.encoded_bytes());
+
+        std::string_view value;
+        REQUIRE(dp::decode(inputStream, value));
+
+        CHECK(value == sample.value);
+    }
 }
 
 TEST_CASE("std::string should be encodable")
@@ -0,0 +1,218 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/detail/posix_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <status-code/posix_code.hpp>
+
+namespace dplx::dp::detail
+{
+
+posix_file::~posix_file() noexcept
+{
+    if (mHandle >= 0)
+    {
+        (void)::close(mHandle);
+    }
+}
+
+auto posix_file::operator=(posix_file &&other) noexcept -> posix_file &
+{
+    if (this != &other)
+    {
+        if (mHandle >= 0)
+        {
+            (void)::close(mHandle);
+        }
+        mHandle = std::exchange(other.mHandle, -1);
+    }
+    return *this;
+}
+
+auto posix_file::open(std::filesystem::path const &path,
+                      file_open_mode const mode) noexcept -> result<posix_file>
+{
+    int flags = O_CLOEXEC;
+    switch (mode)
+    {
+    case file_open_mode::read:
+        flags |= O_RDONLY;
+        break;
+    case file_open_mode::write_truncate:
+        flags |= O_WRONLY | O_CREAT | O_TRUNC;
+        break;
+    }
+
+    constexpr ::mode_t defaultPermissions = 0666;
+    int handle = -1;
+    do
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        handle = ::open(path.c_str(), flags, defaultPermissions);
+    }
+    while (handle < 0 && errno == EINTR);
+
+    if (handle < 0)
+    {
+        return system_error::posix_code::current();
+    }
+    return posix_file(handle);
+}
+
+auto posix_file::size() const noexcept -> result<std::uint64_t>
+{
+    struct ::stat info = {};
+    if (::fstat(mHandle, &info) != 0)
+    {
+        return system_error::posix_code::current();
+    }
+    return static_cast<std::uint64_t>(info.st_size);
+}
+
+auto posix_file::read_at(std::byte *dest,
+                         std::size_t amount,
+                         std::uint64_t offset) const noexcept -> result<void>
+{
+    while (amount > 0U)
+    {
+        auto const numRead
+                = ::pread(mHandle, dest, amount, static_cast<::off_t>(offset));
+        if (numRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return system_error::posix_code::current();
+        }
+        if (numRead == 0)
+        {
+            return errc::end_of_stream;
+        }
+
+        auto const chunkSize = static_cast<std::size_t>(numRead);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        dest += chunkSize;
+        amount -= chunkSize;
+        offset += chunkSize;
+    }
+    return outcome::success();
+}
+
+auto posix_file::write(std::byte const *data, std::size_t size) noexcept
+        -> result<void>
+{
+    while (size > 0U)
+    {
+        auto const numWritten = ::write(mHandle, data, size);
+        if (numWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return system_error::posix_code::current();
+        }
+
+        auto const chunkSize = static_cast<std::size_t>(numWritten);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        data += chunkSize;
+        size -= chunkSize;
+    }
+    return outcome::success();
+}
+
+auto posix_file::write_vectored(
+        std::span<std::span<std::byte const> const> buffers) noexcept
+        -> result<void>
+{
+    // IOV_MAX is at least 16 on every POSIX system
+    constexpr std::size_t maxBatchSize = 16U;
+    std::array<::iovec, maxBatchSize> batch{};
+
+    while (!buffers.empty())
+    {
+        auto const batchSize = std::min(buffers.size(), maxBatchSize);
+        for (std::size_t i = 0U; i < batchSize; ++i)
+        {
+            // writev() doesn't modify the buffer content
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            batch[i].iov_base = const_cast<std::byte *>(buffers[i].data());
+            batch[i].iov_len = buffers[i].size();
+        }
+        buffers = buffers.subspan(batchSize);
+
+        std::span<::iovec> pending(batch.data(), batchSize);
+        while (!pending.empty())
+        {
+            auto const numWritten = ::writev(
+                    mHandle, pending.data(), static_cast<int>(pending.size()));
+            if (numWritten < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return system_error::posix_code::current();
+            }
+
+            // skip fully written buffers and adjust a partially written one
+            auto remaining = static_cast<std::size_t>(numWritten);
+            while (!pending.empty() && remaining >= pending.front().iov_len)
+            {
+                remaining -= pending.front().iov_len;
+                pending = pending.subspan(1U);
+            }
+            if (remaining > 0U)
+            {
+                auto &partial = pending.front();
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                partial.iov_base = static_cast<std::byte *>(partial.iov_base)
+                                   + remaining;
+                partial.iov_len -= remaining;
+            }
+        }
+    }
+    return outcome::success();
+}
+
+auto posix_file::sync_data() noexcept -> result<void>
+{
+#if defined(__APPLE__)
+    // macOS doesn't provide fdatasync()
+    auto const rc = ::fsync(mHandle);
+#else
+    auto const rc = ::fdatasync(mHandle);
+#endif
+    if (rc != 0)
+    {
+        return system_error::posix_code::current();
+    }
+    return outcome::success();
+}
+
+auto posix_file::close() noexcept -> result<void>
+{
+    // POSIX leaves the descriptor state unspecified if close() fails with
+    // EINTR, but on all relevant platforms it is released nonetheless
+    if (mHandle >= 0 && ::close(std::exchange(mHandle, -1)) != 0
+        && errno != EINTR)
+    {
+        return system_error::posix_code::current();
+    }
+    return outcome::success();
+}
+
+} // namespace dplx::dp::detail
@@ -0,0 +1,95 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#include <dplx/dp/disappointment.hpp>
+
+namespace dplx::dp::detail
+{
+
+enum class file_open_mode : unsigned
+{
+    read,
+    write_truncate,
+};
+
+/**
+ * A move-only owner of a POSIX file descriptor. It only wraps the handful of
+ * syscalls needed by the file streams and reports failures as `posix_code`s.
+ */
+class posix_file
+{
+    int mHandle{-1};
+
+public:
+    ~posix_file() noexcept;
+    constexpr posix_file() noexcept = default;
+
+    posix_file(posix_file const &) = delete;
+    auto operator=(posix_file const &) -> posix_file & = delete;
+
+    constexpr posix_file(posix_file &&other) noexcept
+        : mHandle(std::exchange(other.mHandle, -1))
+    {
+    }
+    auto operator=(posix_file &&other) noexcept -> posix_file &;
+
+    constexpr explicit posix_file(int const handle) noexcept
+        : mHandle(handle)
+    {
+    }
+
+    static auto open(std::filesystem::path const &path,
+                     file_open_mode mode) noexcept -> result<posix_file>;
+
+    [[nodiscard]] constexpr auto is_open() const noexcept -> bool
+    {
+        return mHandle >= 0;
+    }
+    [[nodiscard]] constexpr auto native_handle() const noexcept -> int
+    {
+        return mHandle;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> result<std::uint64_t>;
+
+    /**
+     * Reads exactly `amount` bytes starting at `offset`. Fails with
+     * `errc::end_of_stream` if the file ends prematurely.
+     */
+    auto read_at(std::byte *dest,
+                 std::size_t amount,
+                 std::uint64_t offset) const noexcept -> result<void>;
+
+    /**
+     * Writes all bytes to the current file position retrying partial writes.
+     */
+    auto write(std::byte const *data, std::size_t size) noexcept
+            -> result<void>;
+    /**
+     * Writes the buffers in order with as few `writev()` calls as possible.
+     */
+    auto write_vectored(
+            std::span<std::span<std::byte const> const> buffers) noexcept
+            -> result<void>;
+
+    /**
+     * Flushes the file content (but not necessarily its metadata) to the
+     * storage device, i.e. `fdatasync()` where available.
+     */
+    auto sync_data() noexcept -> result<void>;
+
+    auto close() noexcept -> result<void>;
+};
+
+} // namespace dplx::dp::detail
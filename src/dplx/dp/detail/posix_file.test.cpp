@@ -0,0 +1,110 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/detail/posix_file.hpp"
+
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <dplx/cncr/misc.hpp>
+
+#include "blob_matcher.hpp"
+#include "temporary_file.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(std::movable<dp::detail::posix_file>);
+static_assert(!std::copyable<dp::detail::posix_file>);
+
+TEST_CASE("posix_file should be default constructible")
+{
+    dp::detail::posix_file subject;
+    CHECK(!subject.is_open());
+    CHECK(subject.close());
+}
+
+TEST_CASE("posix_file should fail to open a nonexistent file for reading")
+{
+    temporary_file const file;
+    auto openRx = dp::detail::posix_file::open(file.path(),
+                                               dp::detail::file_open_mode::read);
+    CHECK(openRx.has_failure());
+}
+
+TEST_CASE("posix_file can read from a file")
+{
+    constexpr auto content = cncr::make_byte_array<8U>(
+            {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08});
+    temporary_file const file(content);
+
+    auto openRx = dp::detail::posix_file::open(file.path(),
+                                               dp::detail::file_open_mode::read);
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+    REQUIRE(subject.is_open());
+
+    SECTION("should report its size")
+    {
+        CHECK(subject.size().value() == content.size());
+    }
+    SECTION("should read at an offset")
+    {
+        std::array<std::byte, 4U> buffer{};
+        REQUIRE(subject.read_at(buffer.data(), buffer.size(), 2U));
+        CHECK_BLOB_EQ(buffer, std::span(content).subspan(2U, 4U));
+    }
+    SECTION("should fail to read beyond the end")
+    {
+        std::array<std::byte, 4U> buffer{};
+        CHECK(subject.read_at(buffer.data(), buffer.size(), 6U).error()
+              == dp::errc::end_of_stream);
+    }
+    SECTION("should be movable")
+    {
+        auto const handle = subject.native_handle();
+        dp::detail::posix_file moved(std::move(subject));
+        CHECK(moved.native_handle() == handle);
+        // NOLINTNEXTLINE(bugprone-use-after-move)
+        CHECK(!subject.is_open());
+    }
+    SECTION("should be closeable")
+    {
+        CHECK(subject.close());
+        CHECK(!subject.is_open());
+    }
+}
+
+TEST_CASE("posix_file can write to a file")
+{
+    constexpr auto content = cncr::make_byte_array<8U>(
+            {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08});
+    temporary_file const file;
+
+    auto openRx = dp::detail::posix_file::open(
+            file.path(), dp::detail::file_open_mode::write_truncate);
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    SECTION("with write")
+    {
+        REQUIRE(subject.write(content.data(), content.size()));
+        REQUIRE(subject.sync_data());
+        CHECK_BLOB_EQ(file.content(), content);
+    }
+    SECTION("with write_vectored")
+    {
+        std::span<std::byte const> const all(content);
+        std::array<std::span<std::byte const>, 3U> const buffers{
+                all.first(3U), all.subspan(3U, 0U), all.subspan(3U)};
+        REQUIRE(subject.write_vectored(buffers));
+        CHECK_BLOB_EQ(file.content(), content);
+    }
+}
+
+} // namespace dp_tests
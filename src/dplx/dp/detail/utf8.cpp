@@ -0,0 +1,115 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/detail/utf8.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace dplx::dp::detail
+{
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+auto is_valid_utf8(std::byte const *const data, std::size_t const size) noexcept
+        -> bool
+{
+    constexpr std::uint64_t highBits = 0x8080'8080'8080'8080U;
+
+    auto const isContinuation = [data](std::size_t const i) noexcept {
+        return (static_cast<unsigned>(data[i]) & 0xc0U) == 0x80U;
+    };
+
+    std::size_t i = 0U;
+    while (i < size)
+    {
+        if (size - i >= sizeof(std::uint64_t))
+        {
+            std::uint64_t word; // NOLINT(cppcoreguidelines-init-variables)
+            std::memcpy(&word, data + i, sizeof(word));
+            if ((word & highBits) == 0U)
+            {
+                i += sizeof(word);
+                continue;
+            }
+        }
+
+        auto const lead = static_cast<unsigned>(data[i]);
+        if (lead < 0x80U)
+        {
+            i += 1U;
+            continue;
+        }
+
+        // Table 3-7 of the Unicode standard: the lead byte determines the
+        // sequence length and the valid range of the second byte
+        std::size_t length = 0U;
+        unsigned secondMin = 0x80U;
+        unsigned secondMax = 0xbfU;
+        if (lead < 0xc2U)
+        {
+            // a continuation byte or an overlong two byte sequence
+            return false;
+        }
+        if (lead < 0xe0U)
+        {
+            length = 2U;
+        }
+        else if (lead < 0xf0U)
+        {
+            length = 3U;
+            if (lead == 0xe0U)
+            {
+                secondMin = 0xa0U; // overlong
+            }
+            else if (lead == 0xedU)
+            {
+                secondMax = 0x9fU; // surrogates
+            }
+        }
+        else if (lead < 0xf5U)
+        {
+            length = 4U;
+            if (lead == 0xf0U)
+            {
+                secondMin = 0x90U; // overlong
+            }
+            else if (lead == 0xf4U)
+            {
+                secondMax = 0x8fU; // beyond U+10FFFF
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        if (size - i < length)
+        {
+            return false;
+        }
+        auto const second = static_cast<unsigned>(data[i + 1U]);
+        if (second < secondMin || second > secondMax)
+        {
+            return false;
+        }
+        for (std::size_t j = 2U; j < length; ++j)
+        {
+            if (!isContinuation(i + j))
+            {
+                return false;
+            }
+        }
+        i += length;
+    }
+    return true;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+
+} // namespace dplx::dp::detail
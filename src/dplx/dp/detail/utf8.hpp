@@ -0,0 +1,23 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+
+namespace dplx::dp::detail
+{
+
+/**
+ * Checks whether the given bytes are well-formed UTF-8 as defined by the
+ * Unicode standard, i.e. overlong encodings, surrogates and code points
+ * beyond U+10FFFF are rejected.
+ *
+ * ASCII runs are skipped a machine word at a time.
+ */
+auto is_valid_utf8(std::byte const *data, std::size_t size) noexcept -> bool;
+
+} // namespace dplx::dp::detail
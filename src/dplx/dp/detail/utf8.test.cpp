@@ -0,0 +1,63 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/detail/utf8.hpp"
+
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+namespace
+{
+
+auto is_valid_utf8(std::string_view const str) noexcept -> bool
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return dp::detail::is_valid_utf8(reinterpret_cast<std::byte const *>(
+                                             str.data()),
+                                     str.size());
+}
+
+} // namespace
+
+TEST_CASE("is_valid_utf8 should accept well-formed UTF-8")
+{
+    std::string_view const sample = GENERATE(
+            std::string_view{""}, std::string_view{"ascii only text"},
+            std::string_view{"\xc3\xa4"},              // U+00E4
+            std::string_view{"\xe2\x82\xac and more"}, // U+20AC
+            std::string_view{"\xed\x9f\xbf"},          // U+D7FF
+            std::string_view{"\xee\x80\x80"},          // U+E000
+            std::string_view{"0123456789\xf0\x9f\x98\x80"}, // U+1F600
+            std::string_view{"\xf4\x8f\xbf\xbf"});     // U+10FFFF
+    INFO(sample);
+
+    CHECK(is_valid_utf8(sample));
+}
+
+TEST_CASE("is_valid_utf8 should reject ill-formed UTF-8")
+{
+    std::string_view const sample = GENERATE(
+            std::string_view{"\x80"},             // lone continuation
+            std::string_view{"\xc0\xaf"},         // overlong
+            std::string_view{"\xe0\x80\xaf"},     // overlong
+            std::string_view{"\xed\xa0\x80"},     // surrogate
+            std::string_view{"\xf4\x90\x80\x80"}, // beyond U+10FFFF
+            std::string_view{"\xf5\x80\x80\x80"}, // invalid lead byte
+            std::string_view{"abcdefgh\xe2\x82"}, // truncated
+            std::string_view{"\xe2\x28\xa1"});    // invalid continuation
+    INFO(sample);
+
+    CHECK(!is_valid_utf8(sample));
+}
+
+} // namespace dp_tests
@@ -45,6 +45,9 @@ enum class errc : std::uint32_t
     indefinite_item,
     string_exceeds_size_limit,
     buffer_size_exceeded,
+    invalid_utf8,
+    input_not_borrowable,
+    trailing_data,
 
     LIMIT,
 };
@@ -103,6 +106,12 @@ struct status_enum_definition<::dplx::dp::errc>
             "A binary/string CBOR item exceeded a size limit imposed by the user." },
         { code::buffer_size_exceeded, generic_errc::no_buffer_space,
             "The require_input(amount)/ensure_size(amount) call failed due to `amount` exceeding the streams internal buffer size." },
+        { code::invalid_utf8, generic_errc::bad_message,
+            "A text CBOR item did not contain well-formed UTF-8." },
+        { code::input_not_borrowable, generic_errc::invalid_argument,
+            "A borrowed view of content which can't be referenced in place has been requested, but parse_context::borrow_arena is unset." },
+        { code::trailing_data, generic_errc::bad_message,
+            "A byte string which must contain exactly one encoded CBOR item contained additional data." },
             // clang-format on
     };
 
@@ -0,0 +1,154 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+#include <dplx/dp/concepts.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/items/item_push_parser.hpp>
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/streams/memory_input_stream.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * Decodes a stream of `T` items from byte chunks as they arrive, e.g. from
+ * a non-blocking socket or a coroutine based reader:
+ *
+ * @code
+ * for (;;) {
+ *     auto chunk = co_await socket.async_read_some(buffer);
+ *     while (!chunk.empty()) {
+ *         DPLX_TRY(auto rx, decoder.feed(chunk, message));
+ *         chunk = chunk.subspan(rx.consumed);
+ *         if (rx.status == dp::push_parse_status::item_complete) {
+ *             co_await handle(message);
+ *         }
+ *     }
+ * }
+ * @endcode
+ *
+ * The item boundaries are determined by an `item_push_parser`. An item
+ * which is contained in a single chunk is decoded directly from the chunk,
+ * otherwise its bytes are accumulated in an internal buffer which is reused
+ * across items.
+ *
+ * After a failed `feed()` the decoder must be `reset()` before reuse. See
+ * `async_decode()` for a coroutine adapter.
+ */
+template <typename T>
+    requires decodable<T>
+class incremental_decoder
+{
+    item_push_parser mParser;
+    std::vector<std::byte> mBuffer;
+    std::uint64_t mMaxItemSize;
+
+public:
+    incremental_decoder() noexcept
+        : incremental_decoder(UINT64_MAX)
+    {
+    }
+    /**
+     * @param maxItemSize items exceeding this size are rejected with
+     * `errc::buffer_size_exceeded` before they are buffered completely.
+     */
+    explicit incremental_decoder(std::uint64_t const maxItemSize) noexcept
+        : mParser()
+        , mBuffer()
+        , mMaxItemSize(maxItemSize)
+    {
+    }
+
+    /**
+     * Consumes the bytes of `chunk` belonging to the current item. If the
+     * item is completed, it is decoded into `outValue`.
+     */
+    auto feed(std::span<std::byte const> const chunk, T &outValue) noexcept
+            -> result<push_parse_result>
+    {
+        DPLX_TRY(push_parse_result const rx, mParser.feed(chunk));
+        auto const itemBytes = chunk.first(rx.consumed);
+
+        if (rx.status == push_parse_status::need_more_input)
+        {
+            if (mParser.item_size() > mMaxItemSize) [[unlikely]]
+            {
+                return errc::buffer_size_exceeded;
+            }
+            DPLX_TRY(append(itemBytes));
+            return rx;
+        }
+
+        if (mBuffer.empty()) [[likely]]
+        {
+            DPLX_TRY(decode_item(itemBytes, outValue));
+        }
+        else
+        {
+            if (mBuffer.size() + itemBytes.size() > mMaxItemSize) [[unlikely]]
+            {
+                return errc::buffer_size_exceeded;
+            }
+            DPLX_TRY(append(itemBytes));
+            auto decodeRx = decode_item(mBuffer, outValue);
+            mBuffer.clear();
+            if (decodeRx.has_failure()) [[unlikely]]
+            {
+                return static_cast<result<void> &&>(decodeRx).as_failure();
+            }
+        }
+        return rx;
+    }
+
+    void reset() noexcept
+    {
+        mParser.reset();
+        mBuffer.clear();
+    }
+
+    /**
+     * The number of bytes of a partially received item which are currently
+     * buffered.
+     */
+    [[nodiscard]] auto buffered_size() const noexcept -> std::size_t
+    {
+        return mBuffer.size();
+    }
+
+private:
+    auto append(std::span<std::byte const> const bytes) noexcept
+            -> result<void>
+    {
+        try
+        {
+            mBuffer.insert(mBuffer.end(), bytes.begin(), bytes.end());
+        }
+        catch (std::bad_alloc const &)
+        {
+            return errc::not_enough_memory;
+        }
+        return outcome::success();
+    }
+
+    static auto decode_item(std::span<std::byte const> const encoded,
+                            T &outValue) noexcept -> result<void>
+    {
+        memory_input_stream in(encoded);
+        parse_context ctx{in};
+        return codec<T>::decode(ctx, outValue);
+    }
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,82 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/incremental_decoder.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("incremental_decoder should decode items from arbitrary chunks")
+{
+    std::vector<std::vector<int>> messages{
+            {}, {1, 2, 3}, std::vector<int>(200U)};
+    std::iota(messages[2].begin(), messages[2].end(), 1000);
+
+    dp::dynamic_memory_output_stream<> out;
+    for (auto const &message : messages)
+    {
+        REQUIRE(dp::encode(out, message));
+    }
+
+    auto const chunkSize = GENERATE(1U, 3U, 16U, 4096U);
+    INFO(chunkSize);
+
+    dp::incremental_decoder<std::vector<int>> subject;
+    std::vector<std::vector<int>> decoded;
+    std::vector<int> message;
+    std::span<std::byte const> input = out.written();
+    while (!input.empty())
+    {
+        auto chunk = input.first(
+                std::min<std::size_t>(chunkSize, input.size()));
+        input = input.subspan(chunk.size());
+        while (!chunk.empty())
+        {
+            auto feedRx = subject.feed(chunk, message);
+            REQUIRE(feedRx);
+            chunk = chunk.subspan(feedRx.assume_value().consumed);
+            if (feedRx.assume_value().status
+                == dp::push_parse_status::item_complete)
+            {
+                decoded.push_back(message);
+                CHECK(subject.buffered_size() == 0U);
+            }
+        }
+    }
+    CHECK(decoded == messages);
+}
+
+TEST_CASE("incremental_decoder should reject oversized items")
+{
+    std::vector<int> const message(100U);
+    auto encodeRx = dp::encode_to_vector(message);
+    REQUIRE(encodeRx);
+    std::span<std::byte const> const encoded = encodeRx.assume_value();
+
+    dp::incremental_decoder<std::vector<int>> subject(64U);
+    std::vector<int> decoded;
+    REQUIRE(subject.feed(encoded.first(32U), decoded));
+    CHECK(subject.buffered_size() == 32U);
+    CHECK(subject.feed(encoded.subspan(32U, 40U), decoded).error()
+          == dp::errc::buffer_size_exceeded);
+
+    subject.reset();
+    CHECK(subject.buffered_size() == 0U);
+}
+
+} // namespace dp_tests
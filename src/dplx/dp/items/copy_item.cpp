@@ -15,6 +15,7 @@
 #include <dplx/dp/items/emit_core.hpp>
 #include <dplx/dp/items/parse_context.hpp>
 #include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/items/skip_item.hpp>
 #include <dplx/dp/streams/output_buffer.hpp>
 
 namespace dplx::dp
@@ -120,6 +121,23 @@ auto copy_item_to(parse_context &ctx, output_buffer &out) noexcept
     constexpr int majorTypeBitOffset = 5;
     constexpr std::size_t numStackItems = 64;
 
+    if (!ctx.in.empty())
+    {
+        // a completely buffered item is copied with a single bulk copy
+        auto measureRx = detail::measure_item(
+                std::span<std::byte const>(ctx.in.data(), ctx.in.size()));
+        if (measureRx.has_value()) [[likely]]
+        {
+            return detail::bulk_copy(ctx.in, measureRx.assume_value(), out);
+        }
+        if (measureRx.assume_error() != errc::end_of_stream
+            || ctx.in.input_size() <= ctx.in.size())
+        {
+            return static_cast<result<std::size_t> &&>(measureRx).as_failure();
+        }
+        // the item continues beyond the buffered input
+    }
+
     boost::container::small_vector<item_head, numStackItems> stack;
     auto pushItemHead = [&ctx, &out, &stack](item_head head) -> result<void> {
         try
@@ -1,4 +1,3 @@
-
 // Copyright Henrik Steffen Gaßmann 2022
 //
 // Distributed under the Boost Software License, Version 1.0.
@@ -7,15 +6,139 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
 #include <dplx/dp/fwd.hpp>
 
 namespace dplx::dp
 {
 
+/**
+ * Records the sizes computed by `memoized_size_of()` in traversal order.
+ * A `size_of()` pass records them and a subsequent `encode()` pass over the
+ * same value replays them in the same order. Therefore codecs which need
+ * the size of a subitem in order to emit it (e.g. as the length of a byte
+ * string wrapping the subitem) compute it once instead of once per
+ * enclosing level.
+ *
+ * Each size is keyed with the address of the value it has been computed
+ * for. A replay which diverges from the recorded order, i.e. a key
+ * mismatch or a slot which hasn't been assigned, disables the cache. The
+ * same applies to a failed allocation. Afterwards all sizes are recomputed.
+ */
+class size_cache
+{
+    struct entry
+    {
+        void const *key;
+        std::uint64_t size;
+    };
+
+    std::vector<entry> mEntries;
+    std::size_t mNext{0U};
+    std::size_t mNumOpen{0U};
+    bool mReplaying{false};
+    bool mValid{true};
+
+public:
+    static constexpr std::size_t npos = SIZE_MAX;
+
+    [[nodiscard]] auto replaying() const noexcept -> bool
+    {
+        return mReplaying;
+    }
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return mEntries.size();
+    }
+    /// whether the cache hasn't been disabled
+    [[nodiscard]] auto valid() const noexcept -> bool
+    {
+        return mValid;
+    }
+    /// whether the replay consumed every recorded size in order, or the
+    /// cache has been disabled in which case nothing has been replayed
+    [[nodiscard]] auto replay_complete() const noexcept -> bool
+    {
+        return !mValid || mNext == mEntries.size();
+    }
+
+    /// switches from recording to replaying the recorded sizes
+    void start_replay() noexcept
+    {
+        if (mNumOpen != 0U)
+        {
+            // a size_of() pass has been aborted midway
+            mValid = false;
+        }
+        mReplaying = true;
+        mNext = 0U;
+    }
+    void clear() noexcept
+    {
+        mEntries.clear();
+        mNext = 0U;
+        mNumOpen = 0U;
+        mReplaying = false;
+        mValid = true;
+    }
+
+    /// reserves the slot of a size before the sizes of its subitems are
+    /// recorded; returns `npos` if the cache has been disabled
+    auto reserve(void const *const key) noexcept -> std::size_t
+    {
+        if (!mValid)
+        {
+            return npos;
+        }
+        try
+        {
+            mEntries.push_back({key, 0U});
+        }
+        catch (std::bad_alloc const &)
+        {
+            mValid = false;
+            return npos;
+        }
+        ++mNumOpen;
+        return mEntries.size() - 1U;
+    }
+    void assign(std::size_t const slot, std::uint64_t const size) noexcept
+    {
+        if (slot != npos && mValid)
+        {
+            mEntries[slot].size = size;
+            --mNumOpen;
+        }
+    }
+
+    /// returns false if the cache has been disabled, is exhausted or the
+    /// next size has been recorded for a different key
+    auto next(void const *const key, std::uint64_t &size) noexcept -> bool
+    {
+        if (!mValid || mNext == mEntries.size())
+        {
+            return false;
+        }
+        if (mEntries[mNext].key != key) [[unlikely]]
+        {
+            mValid = false;
+            return false;
+        }
+        size = mEntries[mNext++].size;
+        return true;
+    }
+};
+
 struct emit_context
 {
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
     output_buffer &out;
+    /// optional, see `memoized_size_of()`
+    size_cache *sizes{nullptr};
 };
 
 } // namespace dplx::dp
@@ -7,9 +7,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ranges>
+#include <span>
+#include <type_traits>
 
+#include <dplx/dp/detail/bit.hpp>
+#include <dplx/dp/detail/item_size.hpp>
 #include <dplx/dp/disappointment.hpp>
 #include <dplx/dp/items/emit_context.hpp>
 #include <dplx/dp/items/emit_core.hpp>
@@ -19,6 +28,20 @@
 namespace dplx::dp
 {
 
+/**
+ * Determines how `emit_array_backpatched()` and `emit_map_backpatched()`
+ * finalize the item head.
+ */
+enum class backpatch_mode
+{
+    /// the head is shrunk to its minimal encoding and the content is moved
+    /// accordingly, i.e. the output is identical to `emit_array()`
+    shift_content,
+    /// the head keeps its 9 byte encoding which is valid, but not preferred
+    /// CBOR; this avoids moving the content
+    fixed_width,
+};
+
 namespace detail
 {
 
@@ -90,8 +113,143 @@ inline auto emit_indefinite_array_like(emit_context &ctx,
     return dp::emit_break(ctx);
 }
 
+// clang-format off
+template <typename Fn, typename R>
+concept mutable_subitem_emitlet
+        = requires(Fn &&encodeFn,
+                   emit_context ctx,
+                   std::ranges::range_reference_t<R> v)
+        {
+            { static_cast<Fn &&>(encodeFn)(ctx, v) }
+                -> cncr::tryable;
+        };
+// clang-format on
+
+inline constexpr unsigned backpatch_head_size = 1U + sizeof(std::uint64_t);
+
+inline void store_backpatched_head(std::byte *const head,
+                                   std::uint64_t const numElements,
+                                   type_code const type,
+                                   unsigned const headSize) noexcept
+{
+    auto const category = static_cast<unsigned>(type);
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    // NOLINTNEXTLINE(bugprone-switch-missing-default-case)
+    switch (headSize)
+    {
+    case 1U:
+        head[0] = static_cast<std::byte>(category
+                                         | static_cast<unsigned>(numElements));
+        break;
+    case 2U:
+        head[0] = static_cast<std::byte>(category | 24U);
+        head[1] = static_cast<std::byte>(numElements);
+        break;
+    case 3U:
+        head[0] = static_cast<std::byte>(category | 25U);
+        detail::store(head + 1, static_cast<std::uint16_t>(numElements));
+        break;
+    case 5U:
+        head[0] = static_cast<std::byte>(category | 26U);
+        detail::store(head + 1, static_cast<std::uint32_t>(numElements));
+        break;
+    case 9U:
+        head[0] = static_cast<std::byte>(category | 27U);
+        detail::store(head + 1, numElements);
+        break;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+}
+
+template <typename R, typename EncodeElementFn>
+inline auto emit_backpatched_array_like(emit_context &ctx,
+                                        R &&vs,
+                                        type_code const type,
+                                        backpatch_mode const mode,
+                                        EncodeElementFn &&encodeElement) noexcept
+        -> result<void>
+{
+    DPLX_TRY(ctx.out.ensure_size(backpatch_head_size));
+    auto const retained = ctx.out.retained_output();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (retained.data() + retained.size() != ctx.out.data()) [[unlikely]]
+    {
+        // the stream may flush the head before it can be patched
+        return errc::buffer_size_exceeded;
+    }
+    auto const headOffset = retained.size();
+    ctx.out.commit_written(backpatch_head_size);
+
+    std::uint64_t numElements = 0U;
+    for (auto &&v : vs)
+    {
+        DPLX_TRY(static_cast<EncodeElementFn &&>(encodeElement)(ctx, v));
+        numElements += 1U;
+    }
+
+    // the elements may have caused a reallocation
+    auto const output = ctx.out.retained_output();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto *const head = output.data() + headOffset;
+    if (mode == backpatch_mode::fixed_width)
+    {
+        detail::store_backpatched_head(head, numElements, type,
+                                       backpatch_head_size);
+        return outcome::success();
+    }
+
+    auto const headSize = detail::var_uint_encoded_size(numElements);
+    auto const contentSize = output.size() - headOffset - backpatch_head_size;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memmove(head + headSize, head + backpatch_head_size, contentSize);
+    detail::store_backpatched_head(head, numElements, type, headSize);
+    ctx.out.uncommit_written(backpatch_head_size - headSize);
+    return outcome::success();
+}
+
 } // namespace detail
 
+/**
+ * Emits an array in a single pass over `vs` by reserving a 9 byte head
+ * which is patched after all elements have been emitted. Therefore it
+ * supports input ranges like lazy views and generators. The output stream
+ * must retain its output, see `output_buffer::retained_output()`, otherwise
+ * `errc::buffer_size_exceeded` is returned.
+ */
+template <std::ranges::input_range R, typename EncodeElementFn>
+    requires detail::mutable_subitem_emitlet<std::remove_cvref_t<EncodeElementFn>,
+                                             R>
+inline auto
+emit_array_backpatched(emit_context &ctx,
+                       R &&vs,
+                       EncodeElementFn &&encodeElement,
+                       backpatch_mode const mode
+                       = backpatch_mode::shift_content) noexcept -> result<void>
+{
+    return detail::emit_backpatched_array_like(
+            ctx, static_cast<R &&>(vs), type_code::array, mode,
+            static_cast<EncodeElementFn &&>(encodeElement));
+}
+/**
+ * Emits a map in a single pass, see `emit_array_backpatched()`.
+ */
+template <std::ranges::input_range R, typename EncodeElementFn>
+    requires detail::mutable_subitem_emitlet<std::remove_cvref_t<EncodeElementFn>,
+                                             R>
+inline auto
+emit_map_backpatched(emit_context &ctx,
+                     R &&vs,
+                     EncodeElementFn &&encodeElement,
+                     backpatch_mode const mode
+                     = backpatch_mode::shift_content) noexcept -> result<void>
+{
+    return detail::emit_backpatched_array_like(
+            ctx, static_cast<R &&>(vs), type_code::map, mode,
+            static_cast<EncodeElementFn &&>(encodeElement));
+}
+
 template <std::ranges::input_range R, typename EncodeElementFn>
     requires(std::ranges::forward_range<R> || std::ranges::sized_range<R>)
             && detail::subitem_emitlet<std::remove_cvref_t<EncodeElementFn>, R>
@@ -138,4 +296,203 @@ inline auto emit_map_indefinite(emit_context &ctx,
             static_cast<EncodeElementFn &&>(encodeElement));
 }
 
+// clang-format off
+template <typename T>
+concept arithmetic_array_element
+    = detail::encodable_int<T>
+    || std::same_as<T, float> || std::same_as<T, double>;
+// clang-format on
+
+namespace detail
+{
+
+inline constexpr std::size_t integer_array_block_size = 8U;
+
+// grows the output buffer to hold a whole block; yields false if the stream
+// can't provide that much space at once, e.g. a fixed buffer sized with
+// encoded_size_of() lacks the slack. In that case the block must be emitted
+// element by element which refills the buffer as needed.
+inline auto try_reserve_block(emit_context &ctx,
+                              std::size_t const size) noexcept -> result<bool>
+{
+    if (auto growRx = ctx.out.ensure_size(size); growRx.has_failure())
+            [[unlikely]]
+    {
+        if (growRx.assume_error() == errc::end_of_stream
+            || growRx.assume_error() == errc::buffer_size_exceeded)
+        {
+            return false;
+        }
+        return static_cast<result<void> &&>(growRx).as_failure();
+    }
+    return true;
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+
+// encodes up to integer_array_block_size integers with a single buffer size
+// check; the payloads are stored with the full width of code_type, i.e. the
+// excess bytes are overwritten by the next element or left uncommitted
+template <encodable_int T>
+inline auto emit_integer_block(emit_context &ctx,
+                               T const *const values,
+                               std::size_t const numValues) noexcept
+        -> result<void>
+{
+    using code_type = encoder_uint_t<T>;
+    constexpr std::size_t slack = sizeof(code_type);
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-member-init)
+    std::array<code_type, integer_array_block_size> payloads;
+    std::array<unsigned, integer_array_block_size> heads;
+    std::array<unsigned, integer_array_block_size> sizes;
+    // NOLINTEND(cppcoreguidelines-pro-type-member-init)
+
+    std::size_t blockSize = 0U;
+    for (std::size_t i = 0U; i < numValues; ++i)
+    {
+        code_type uvalue; // NOLINT(cppcoreguidelines-init-variables)
+        unsigned category; // NOLINT(cppcoreguidelines-init-variables)
+        if constexpr (!std::is_signed_v<T>)
+        {
+            uvalue = static_cast<code_type>(values[i]);
+            category = static_cast<unsigned>(type_code::posint);
+        }
+        else
+        {
+            using uvalue_type = std::make_unsigned_t<T>;
+            auto const signmask = static_cast<uvalue_type>(
+                    values[i] >> (digits_v<uvalue_type> - 1U));
+            // complement negatives
+            uvalue = static_cast<code_type>(
+                    signmask ^ static_cast<uvalue_type>(values[i]));
+            category = static_cast<unsigned>(
+                    signmask & static_cast<uvalue_type>(type_code::negint));
+        }
+
+        // same width computation as store_var_uint(), but without branches;
+        // the bit index arguments are or'ed with one in order to avoid
+        // passing zero for inline values whose results are discarded anyway
+        bool const isInline = uvalue <= inline_value_max;
+        auto const lastSetBitIndex = static_cast<unsigned>(
+                detail::find_last_set_bit(uvalue | 1U));
+        auto const bytePowerPlus2
+                = isInline ? 1U
+                           : static_cast<unsigned>(detail::find_last_set_bit(
+                                   lastSetBitIndex | 1U));
+        unsigned const bitSize = 2U << bytePowerPlus2;
+        unsigned const byteSize = 1U + (bitSize >> 3);
+
+        heads[i] = category
+                 | (isInline ? static_cast<unsigned>(uvalue)
+                             : inline_value_max + bytePowerPlus2 - 1U);
+        payloads[i] = static_cast<code_type>(
+                uvalue << (digits_v<code_type> - bitSize));
+        sizes[i] = byteSize;
+        blockSize += byteSize;
+    }
+
+    DPLX_TRY(bool const reserved,
+             detail::try_reserve_block(ctx, blockSize + slack));
+    if (!reserved) [[unlikely]]
+    {
+        for (std::size_t i = 0U; i < numValues; ++i)
+        {
+            DPLX_TRY(dp::emit_integer(ctx, values[i]));
+        }
+        return outcome::success();
+    }
+
+    std::byte *dest = ctx.out.data();
+    for (std::size_t i = 0U; i < numValues; ++i)
+    {
+        *dest = static_cast<std::byte>(heads[i]);
+        detail::store(dest + 1, payloads[i]);
+        dest += sizes[i];
+    }
+    ctx.out.commit_written(blockSize);
+    return outcome::success();
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+template <typename T>
+    requires std::floating_point<T>
+inline auto emit_float_block(emit_context &ctx,
+                             T const *const values,
+                             std::size_t const numValues) noexcept
+        -> result<void>
+{
+    constexpr std::size_t encodedSize = 1U + sizeof(T);
+    constexpr auto head = static_cast<std::byte>(
+            sizeof(T) == sizeof(float) ? type_code::float_single
+                                       : type_code::float_double);
+
+    std::size_t const blockSize = numValues * encodedSize;
+    DPLX_TRY(bool const reserved, detail::try_reserve_block(ctx, blockSize));
+    if (!reserved) [[unlikely]]
+    {
+        for (std::size_t i = 0U; i < numValues; ++i)
+        {
+            if constexpr (sizeof(T) == sizeof(float))
+            {
+                DPLX_TRY(dp::emit_float_single(ctx, values[i]));
+            }
+            else
+            {
+                DPLX_TRY(dp::emit_float_double(ctx, values[i]));
+            }
+        }
+        return outcome::success();
+    }
+
+    std::byte *dest = ctx.out.data();
+    for (std::size_t i = 0U; i < numValues; ++i, dest += encodedSize)
+    {
+        *dest = head;
+        detail::store(dest + 1, values[i]);
+    }
+    ctx.out.commit_written(blockSize);
+    return outcome::success();
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+} // namespace detail
+
+/**
+ * Emits an array of integers or floating point numbers. The output is
+ * identical to `emit_array(ctx, vs, dp::encode)`, however, the elements are
+ * processed in blocks which share a single output buffer size check.
+ */
+template <arithmetic_array_element T>
+inline auto emit_arithmetic_array(emit_context &ctx,
+                                  std::span<T const> const vs) noexcept
+        -> result<void>
+{
+    DPLX_TRY(dp::emit_array(ctx, vs.size()));
+
+    if constexpr (std::floating_point<T>)
+    {
+        constexpr std::size_t blockSize
+                = minimum_output_buffer_size / (1U + sizeof(T));
+        for (std::size_t i = 0U; i < vs.size(); i += blockSize)
+        {
+            DPLX_TRY(detail::emit_float_block(
+                    ctx, vs.data() + i, std::min(blockSize, vs.size() - i)));
+        }
+    }
+    else
+    {
+        constexpr std::size_t blockSize = detail::integer_array_block_size;
+        for (std::size_t i = 0U; i < vs.size(); i += blockSize)
+        {
+            DPLX_TRY(detail::emit_integer_block(
+                    ctx, vs.data() + i, std::min(blockSize, vs.size() - i)));
+        }
+    }
+    return outcome::success();
+}
+
 } // namespace dplx::dp
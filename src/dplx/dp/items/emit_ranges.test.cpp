@@ -7,7 +7,13 @@
 
 #include "dplx/dp/items/emit_ranges.hpp"
 
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -17,6 +23,8 @@
 #include <dplx/dp/codecs/core.hpp>
 #include <dplx/dp/indefinite_range.hpp>
 #include <dplx/dp/items/item_size_of_ranges.hpp>
+#include <dplx/dp/streams/dynamic_memory_output_stream.hpp>
+#include <dplx/dp/streams/memory_output_stream.hpp>
 
 #include "blob_matcher.hpp"
 #include "item_sample_ct.hpp"
@@ -192,6 +200,159 @@ TEST_CASE("emit_map_indefinite loops over an input range of encodable pairs "
     }
 }
 
+TEST_CASE("emit_array_backpatched emits an input range in a single pass")
+{
+    item_sample_rt<std::vector<int>> const sample
+            = GENERATE(load_samples_from_yaml<std::vector<int>>("arrays.yaml",
+                                                                "int arrays"));
+    INFO(sample);
+
+    // dereferencing counts the passes over the range
+    int numDerefs = 0;
+    auto const view = sample.value
+                    | std::views::transform([&numDerefs](int const v) {
+                          ++numDerefs;
+                          return v;
+                      });
+
+    dp::dynamic_memory_output_stream<> out;
+    dp::emit_context ctx{out};
+
+    SECTION("with a minimal head")
+    {
+        REQUIRE(dp::emit_array_backpatched(ctx, view, dp::encode));
+
+        CHECK_BLOB_EQ(out.written(), sample.encoded_bytes());
+        CHECK(numDerefs == static_cast<int>(sample.value.size()));
+    }
+    SECTION("with a fixed width head")
+    {
+        REQUIRE(dp::emit_array_backpatched(ctx, view, dp::encode,
+                                           dp::backpatch_mode::fixed_width));
+
+        auto const headSize = dp::encoded_item_head_size(dp::type_code::array,
+                                                         sample.value.size());
+        auto const written = out.written();
+        REQUIRE(written.size() == sample.encoded.size() - headSize + 9U);
+        CHECK(written[0] == (to_byte(dp::type_code::array) | std::byte{27}));
+        CHECK(dp::detail::load<std::uint64_t>(written.data() + 1)
+              == sample.value.size());
+        CHECK_BLOB_EQ(written.subspan(9U),
+                      std::span(sample.encoded_bytes()).subspan(headSize));
+        CHECK(numDerefs == static_cast<int>(sample.value.size()));
+    }
+}
+
+TEST_CASE("emit_array_backpatched appends to existing output")
+{
+    std::array<std::byte, 64U> buffer{};
+    dp::memory_output_stream out(buffer);
+    dp::emit_context ctx{out};
+
+    REQUIRE(dp::encode(ctx, 0x1'0000));
+    std::vector<int> const values(30U, 7);
+    REQUIRE(dp::emit_array_backpatched(ctx, values, dp::encode));
+
+    auto const written = out.written();
+    REQUIRE(written.size() == 5U + 2U + 30U);
+    CHECK(written[5] == (to_byte(dp::type_code::array) | std::byte{24}));
+    CHECK(written[6] == std::byte{30});
+    CHECK(written.back() == std::byte{7});
+}
+
+TEST_CASE("emit_array_backpatched requires a retaining output stream")
+{
+    simple_test_emit_context ctx(16U);
+    std::vector<int> const values{1, 2, 3};
+
+    CHECK(dp::emit_array_backpatched(ctx.as_emit_context(), values, dp::encode)
+                  .error()
+          == dp::errc::buffer_size_exceeded);
+}
+
+TEST_CASE("emit_map_backpatched emits a range of pairs in a single pass")
+{
+    item_sample_rt<std::vector<std::pair<int, int>>> const sample
+            = GENERATE(load_samples_from_yaml<std::vector<std::pair<int, int>>>(
+                    "maps.yaml", "int maps"));
+    INFO(sample);
+
+    dp::dynamic_memory_output_stream<> out;
+    dp::emit_context ctx{out};
+    auto encodePair = [](dp::emit_context &lctx,
+                         std::pair<int, int> const &pair) -> result<void> {
+        DPLX_TRY(dp::encode(lctx, pair.first));
+        return dp::encode(lctx, pair.second);
+    };
+
+    REQUIRE(dp::emit_map_backpatched(ctx, dp::indefinite_range(sample.value),
+                                     encodePair));
+
+    CHECK_BLOB_EQ(out.written(), sample.encoded_bytes());
+}
+
+TEST_CASE("emit_arithmetic_array emits the same bytes as emit_array")
+{
+    item_sample_rt<std::vector<int>> const sample
+            = GENERATE(load_samples_from_yaml<std::vector<int>>("arrays.yaml",
+                                                                "int arrays"));
+    INFO(sample);
+
+    // an exactly sized buffer leaves no room for the block slack
+    simple_test_emit_context ctx(sample.encoded.size());
+
+    REQUIRE(dp::emit_arithmetic_array(ctx.as_emit_context(),
+                                      std::span<int const>(sample.value)));
+
+    CHECK_BLOB_EQ(ctx.stream.written(), sample.encoded_bytes());
+}
+
+TEST_CASE("emit_arithmetic_array handles every encoding width")
+{
+    std::vector<std::int64_t> integers(20U);
+    std::iota(integers.begin(), integers.end(), std::int64_t{-4});
+    for (std::int64_t const v :
+         {std::int64_t{24}, std::int64_t{-25}, std::int64_t{255},
+          std::int64_t{-256}, std::int64_t{256}, std::int64_t{-65'537},
+          std::int64_t{0x1'0000'0000}, std::numeric_limits<std::int64_t>::min(),
+          std::numeric_limits<std::int64_t>::max()})
+    {
+        integers.push_back(v);
+    }
+    std::vector<std::uint16_t> const shorts{0U, 23U, 24U, 255U, 256U, 0xffffU};
+    std::vector<double> const doubles{0.0, -1.5, 1e300, 2.0, 3.0, -0.0};
+    std::vector<float> const floats(11U, 0.25F);
+
+    auto const check = [](auto const &values) {
+        dp::dynamic_memory_output_stream<> expected;
+        dp::emit_context expectedCtx{expected};
+        REQUIRE(dp::emit_array(expectedCtx, values, dp::encode));
+
+        dp::dynamic_memory_output_stream<> out;
+        dp::emit_context ctx{out};
+        REQUIRE(dp::emit_arithmetic_array(ctx, std::span(values)));
+
+        CHECK_BLOB_EQ(out.written(), expected.written());
+    };
+
+    SECTION("for int64")
+    {
+        check(integers);
+    }
+    SECTION("for uint16")
+    {
+        check(shorts);
+    }
+    SECTION("for double")
+    {
+        check(doubles);
+    }
+    SECTION("for float")
+    {
+        check(floats);
+    }
+}
+
 } // namespace dp_tests
 
 // NOLINTEND(readability-function-cognitive-complexity)
@@ -0,0 +1,224 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/item_push_parser.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/streams/memory_input_stream.hpp>
+
+namespace dplx::dp
+{
+
+namespace
+{
+
+// the encoded size of an item head as determined by its first byte; invalid
+// heads are rejected by parse_item_head()
+constexpr auto encoded_head_size(std::byte const indicator) noexcept
+        -> unsigned
+{
+    auto const addInfo = static_cast<unsigned>(indicator)
+                         & detail::item_inline_info_mask;
+    if (addInfo <= detail::inline_value_max
+        || addInfo > detail::item_var_int_coding_threshold)
+    {
+        return 1U;
+    }
+    return 1U + (1U << (addInfo - (detail::inline_value_max + 1U)));
+}
+
+} // namespace
+
+void item_push_parser::reset() noexcept
+{
+    mStack.clear();
+    mPayloadRemaining = 0U;
+    mItemSize = 0U;
+    mHeadSize = 0U;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+auto item_push_parser::feed(std::span<std::byte const> const chunk) noexcept
+        -> result<push_parse_result>
+{
+    memory_input_stream in(chunk);
+    parse_context ctx{in};
+
+    auto const finish = [&](push_parse_status const status) noexcept {
+        auto const consumed = chunk.size() - in.size();
+        mItemSize += consumed;
+        if (status == push_parse_status::item_complete)
+        {
+            mItemSize = 0U;
+        }
+        return push_parse_result{consumed, status};
+    };
+
+    while (!in.empty())
+    {
+        if (mPayloadRemaining > 0U)
+        {
+            auto const amount = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(mPayloadRemaining, in.size()));
+            in.discard_buffered(amount);
+            mPayloadRemaining -= amount;
+            if (mPayloadRemaining == 0U && complete_item())
+            {
+                return finish(push_parse_status::item_complete);
+            }
+            continue;
+        }
+
+        item_head head; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        if (mHeadSize == 0U && in.size() >= detail::var_uint_max_size)
+            [[likely]]
+        {
+            DPLX_TRY(head, dp::parse_item_head(ctx));
+        }
+        else
+        {
+            // the item head straddles the chunk boundary
+            auto const headSize = encoded_head_size(
+                    mHeadSize == 0U ? *in.data() : mHeadBuffer[0]);
+            auto const amount
+                    = std::min<std::size_t>(headSize - mHeadSize, in.size());
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy(static_cast<std::byte *>(mHeadBuffer) + mHeadSize,
+                        in.data(), amount);
+            in.discard_buffered(amount);
+            mHeadSize += static_cast<unsigned>(amount);
+            if (mHeadSize < headSize)
+            {
+                break;
+            }
+            mHeadSize = 0U;
+
+            memory_input_stream headIn(std::span<std::byte const>(
+                    static_cast<std::byte const *>(mHeadBuffer), headSize));
+            parse_context headCtx{headIn};
+            DPLX_TRY(head, dp::parse_item_head(headCtx));
+        }
+
+        DPLX_TRY(bool const complete, on_item_head(head));
+        if (complete)
+        {
+            return finish(push_parse_status::item_complete);
+        }
+    }
+    return finish(push_parse_status::need_more_input);
+}
+
+auto item_push_parser::on_item_head(item_head const &head) noexcept
+        -> result<bool>
+{
+    if (!mStack.empty() && mStack.back().indefinite
+        && (mStack.back().type == type_code::binary
+            || mStack.back().type == type_code::text))
+    {
+        if (head.is_special_break())
+        {
+            mStack.pop_back();
+            return complete_item();
+        }
+        // neither finite nor indefinite binary/text items can be nested
+        if (head.type != mStack.back().type || head.indefinite())
+        {
+            return errc::invalid_indefinite_subitem;
+        }
+        mPayloadRemaining = head.value;
+        return mPayloadRemaining == 0U && complete_item();
+    }
+
+    frame subFrame{0U, head.type, head.indefinite()};
+    switch (head.type)
+    {
+    case type_code::posint:
+    case type_code::negint:
+        return complete_item();
+
+    case type_code::special:
+        if (head.is_special_break())
+        {
+            if (mStack.empty() || !mStack.back().indefinite
+                // an odd number of items in a map
+                || (mStack.back().type == type_code::map
+                    && (mStack.back().count & 1U) != 0U))
+            {
+                return errc::item_type_mismatch;
+            }
+            mStack.pop_back();
+        }
+        return complete_item();
+
+    case type_code::tag:
+        // the tagged item completes the current slot
+        return false;
+
+    case type_code::binary:
+    case type_code::text:
+        if (!head.indefinite())
+        {
+            mPayloadRemaining = head.value;
+            return mPayloadRemaining == 0U && complete_item();
+        }
+        break;
+
+    case type_code::array:
+    case type_code::map:
+        if (!head.indefinite())
+        {
+            if (head.value == 0U)
+            {
+                return complete_item();
+            }
+            if (head.type == type_code::map && head.value > UINT64_MAX / 2U)
+            {
+                return errc::item_value_out_of_range;
+            }
+            subFrame.count = head.type == type_code::map ? head.value * 2U
+                                                         : head.value;
+        }
+        break;
+
+    default:
+        return errc::invalid_additional_information;
+    }
+
+    try
+    {
+        mStack.push_back(subFrame);
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+    return false;
+}
+
+auto item_push_parser::complete_item() noexcept -> bool
+{
+    while (!mStack.empty())
+    {
+        auto &top = mStack.back();
+        if (top.indefinite)
+        {
+            top.count += 1U;
+            return false;
+        }
+        if (--top.count != 0U)
+        {
+            return false;
+        }
+        mStack.pop_back();
+    }
+    return true;
+}
+
+} // namespace dplx::dp
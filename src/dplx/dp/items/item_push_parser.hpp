@@ -0,0 +1,100 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <boost/container/small_vector.hpp>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/items/type_code.hpp>
+
+namespace dplx::dp
+{
+
+enum class push_parse_status
+{
+    /// the item continues beyond the fed bytes
+    need_more_input,
+    /// the item ends within the fed bytes, see `push_parse_result::consumed`
+    item_complete,
+};
+
+struct push_parse_result
+{
+    /// the number of bytes belonging to the current item; if the item is
+    /// complete, the remaining bytes belong to the next item
+    std::size_t consumed;
+    push_parse_status status;
+};
+
+/**
+ * A resumable (sans-IO) parser which delimits a single CBOR item.
+ *
+ * The input is fed in arbitrarily sized chunks as it arrives. The parser
+ * validates the item structure and keeps its position within the item tree
+ * in an explicit stack (like `skip_item()`), i.e. it never blocks and only
+ * ever copies partially received item heads. Once an item is complete, the
+ * parser is ready for the next one.
+ *
+ * After a failed `feed()` the parser must be `reset()` before reuse.
+ */
+class item_push_parser
+{
+    struct frame
+    {
+        // the number of remaining subitems of a definite container or the
+        // number of parsed subitems of an indefinite item
+        std::uint64_t count;
+        type_code type;
+        bool indefinite;
+    };
+
+    static constexpr std::size_t inline_stack_size = 16U;
+
+    boost::container::small_vector<frame, inline_stack_size> mStack;
+    std::uint64_t mPayloadRemaining{0U};
+    std::uint64_t mItemSize{0U};
+    unsigned mHeadSize{0U};
+    std::byte mHeadBuffer[detail::var_uint_max_size]{};
+
+public:
+    item_push_parser() noexcept = default;
+
+    /**
+     * Parses as much of `chunk` as belongs to the current item.
+     */
+    auto feed(std::span<std::byte const> chunk) noexcept
+            -> result<push_parse_result>;
+
+    void reset() noexcept;
+
+    /**
+     * The number of bytes consumed of the current item so far.
+     */
+    [[nodiscard]] auto item_size() const noexcept -> std::uint64_t
+    {
+        return mItemSize;
+    }
+    /**
+     * The number of open containers and indefinite strings.
+     */
+    [[nodiscard]] auto depth() const noexcept -> std::size_t
+    {
+        return mStack.size();
+    }
+
+private:
+    auto on_item_head(item_head const &head) noexcept -> result<bool>;
+    auto complete_item() noexcept -> bool;
+};
+
+} // namespace dplx::dp
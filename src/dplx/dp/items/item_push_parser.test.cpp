@@ -0,0 +1,153 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/item_push_parser.hpp"
+
+#include <array>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/codecs/std-string.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+namespace
+{
+
+// feeds the input in chunks of chunkSize and returns the item sizes
+auto delimit(std::span<std::byte const> input, std::size_t const chunkSize)
+        -> dp::result<std::vector<std::size_t>>
+{
+    dp::item_push_parser subject;
+    std::vector<std::size_t> itemSizes;
+    std::size_t itemSize = 0U;
+    while (!input.empty())
+    {
+        auto chunk = input.first(std::min(chunkSize, input.size()));
+        while (!chunk.empty())
+        {
+            DPLX_TRY(dp::push_parse_result const rx, subject.feed(chunk));
+            itemSize += rx.consumed;
+            chunk = chunk.subspan(rx.consumed);
+            input = input.subspan(rx.consumed);
+            if (rx.status == dp::push_parse_status::item_complete)
+            {
+                itemSizes.push_back(itemSize);
+                itemSize = 0U;
+            }
+        }
+    }
+    if (subject.item_size() != 0U || subject.depth() != 0U)
+    {
+        return dp::errc::end_of_stream;
+    }
+    return itemSizes;
+}
+
+} // namespace
+
+TEST_CASE("item_push_parser should delimit encoded values")
+{
+    std::vector<std::string> const strings{"", "a", std::string(300U, 'x')};
+    std::vector<std::vector<int>> const nested{{}, {1, -1000, 0x7fff'ffff}};
+
+    dp::dynamic_memory_output_stream<> out;
+    REQUIRE(dp::encode(out, strings));
+    auto const firstSize = out.written_size();
+    REQUIRE(dp::encode(out, nested));
+    auto const secondSize = out.written_size() - firstSize;
+    REQUIRE(dp::encode(out, 0x1'0000'0000ULL));
+    auto const thirdSize = out.written_size() - firstSize - secondSize;
+
+    auto const chunkSize = GENERATE(1U, 2U, 3U, 8U, 9U, 64U, 4096U);
+    INFO(chunkSize);
+    auto const delimitRx = delimit(out.written(), chunkSize);
+    REQUIRE(delimitRx);
+    std::vector<std::size_t> const expected{firstSize, secondSize, thirdSize};
+    CHECK(delimitRx.assume_value() == expected);
+}
+
+TEST_CASE("item_push_parser should delimit indefinite items")
+{
+    // tag(1) [_ "ab"_, {_ 1: h'', 2: (_ "c", "d") }, [] ]
+    std::array const encoded{
+            std::byte{0xc1}, std::byte{0x9f}, std::byte{0x7f},
+            std::byte{0x62}, std::byte{0x61}, std::byte{0x62},
+            std::byte{0xff}, std::byte{0xbf}, std::byte{0x01},
+            std::byte{0x40}, std::byte{0x02}, std::byte{0x7f},
+            std::byte{0x61}, std::byte{0x63}, std::byte{0x61},
+            std::byte{0x64}, std::byte{0xff}, std::byte{0xff},
+            std::byte{0x80}, std::byte{0xff}, std::byte{0xf6}};
+
+    auto const chunkSize = GENERATE(1U, 2U, 5U, 64U);
+    INFO(chunkSize);
+    auto const delimitRx = delimit(encoded, chunkSize);
+    REQUIRE(delimitRx);
+    std::vector<std::size_t> const expected{20U, 1U};
+    CHECK(delimitRx.assume_value() == expected);
+}
+
+TEST_CASE("item_push_parser should report need_more_input")
+{
+    std::array const encoded{std::byte{0x82}, std::byte{0x19},
+                             std::byte{0x01}, std::byte{0x00},
+                             std::byte{0x01}};
+    dp::item_push_parser subject;
+
+    auto const firstRx = subject.feed(std::span(encoded).first(2U));
+    REQUIRE(firstRx);
+    CHECK(firstRx.assume_value().consumed == 2U);
+    CHECK(firstRx.assume_value().status
+          == dp::push_parse_status::need_more_input);
+    CHECK(subject.depth() == 1U);
+    CHECK(subject.item_size() == 2U);
+
+    auto const secondRx = subject.feed(std::span(encoded).subspan(2U));
+    REQUIRE(secondRx);
+    CHECK(secondRx.assume_value().consumed == 3U);
+    CHECK(secondRx.assume_value().status
+          == dp::push_parse_status::item_complete);
+    CHECK(subject.depth() == 0U);
+    CHECK(subject.item_size() == 0U);
+}
+
+TEST_CASE("item_push_parser should reject malformed items")
+{
+    dp::item_push_parser subject;
+    SECTION("a stray break")
+    {
+        std::array const encoded{std::byte{0xff}};
+        CHECK(subject.feed(encoded).error() == dp::errc::item_type_mismatch);
+    }
+    SECTION("a break after a map key")
+    {
+        std::array const encoded{std::byte{0xbf}, std::byte{0x01},
+                                 std::byte{0xff}};
+        CHECK(subject.feed(encoded).error() == dp::errc::item_type_mismatch);
+    }
+    SECTION("a nested indefinite string")
+    {
+        std::array const encoded{std::byte{0x5f}, std::byte{0x5f}};
+        CHECK(subject.feed(encoded).error()
+              == dp::errc::invalid_indefinite_subitem);
+    }
+    SECTION("a reserved additional information value")
+    {
+        std::array const encoded{std::byte{0x1c}};
+        CHECK(subject.feed(encoded).error()
+              == dp::errc::invalid_additional_information);
+    }
+}
+
+} // namespace dp_tests
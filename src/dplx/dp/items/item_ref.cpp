@@ -0,0 +1,171 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/item_ref.hpp"
+
+#include <new>
+
+#include <dplx/dp/items/skip_item.hpp>
+
+namespace dplx::dp
+{
+
+auto item_ref::parse(std::span<std::byte const> const encoded) noexcept
+        -> result<item_ref>
+{
+    memory_input_stream in(encoded);
+    parse_context ctx{in};
+
+    item_ref ref;
+    DPLX_TRY(ref.mHead, dp::parse_item_head(ctx));
+    if (ref.mHead.is_special_break())
+    {
+        return errc::item_type_mismatch;
+    }
+    ref.mEncoded = encoded;
+    return ref;
+}
+
+auto item_ref::binary() const noexcept -> result<std::span<std::byte const>>
+{
+    return string_content(type_code::binary);
+}
+
+auto item_ref::text() const noexcept -> result<std::u8string_view>
+{
+    DPLX_TRY(std::span<std::byte const> const content,
+             string_content(type_code::text));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return std::u8string_view(reinterpret_cast<char8_t const *>(content.data()),
+                              content.size());
+}
+
+auto item_ref::at(std::size_t const i) const noexcept -> result<item_ref>
+{
+    if (mHead.type != type_code::array)
+    {
+        return errc::item_type_mismatch;
+    }
+    DPLX_TRY(std::size_t const offset, locate_subitem(i));
+    return item_ref::parse(mEncoded.subspan(offset));
+}
+
+auto item_ref::operator[](std::u8string_view const key) const noexcept
+        -> result<item_ref>
+{
+    if (mHead.type != type_code::map)
+    {
+        return errc::item_type_mismatch;
+    }
+    for (std::size_t i = 0U;; i += 2U)
+    {
+        auto locateRx = locate_subitem(i);
+        if (locateRx.has_failure())
+        {
+            if (locateRx.assume_error() == errc::item_value_out_of_range)
+            {
+                break;
+            }
+            return static_cast<result<std::size_t> &&>(locateRx).as_failure();
+        }
+
+        DPLX_TRY(item_ref const candidate,
+                 item_ref::parse(mEncoded.subspan(locateRx.assume_value())));
+        if (candidate.type() != type_code::text || candidate.indefinite())
+        {
+            continue;
+        }
+        DPLX_TRY(std::u8string_view const candidateKey, candidate.text());
+        if (candidateKey == key)
+        {
+            DPLX_TRY(std::size_t const offset, locate_subitem(i + 1U));
+            return item_ref::parse(mEncoded.subspan(offset));
+        }
+    }
+    return errc::unknown_property;
+}
+
+auto item_ref::string_content(type_code const expectedType) const noexcept
+        -> result<std::span<std::byte const>>
+{
+    if (mHead.type != expectedType)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (mHead.indefinite())
+    {
+        return errc::indefinite_item;
+    }
+    auto const available = mEncoded.size() - mHead.encoded_length;
+    if (mHead.value > available)
+    {
+        return errc::end_of_stream;
+    }
+    return mEncoded.subspan(mHead.encoded_length,
+                            static_cast<std::size_t>(mHead.value));
+}
+
+auto item_ref::locate_subitem(std::size_t const n) const noexcept
+        -> result<std::size_t>
+{
+    if (!mHead.indefinite())
+    {
+        auto const numSubitems = mHead.type == type_code::map
+                                         ? mHead.value * 2U
+                                         : mHead.value;
+        if (n >= numSubitems)
+        {
+            return errc::item_value_out_of_range;
+        }
+    }
+    if (n < mSubitemOffsets.size())
+    {
+        return mSubitemOffsets[n];
+    }
+
+    memory_input_stream in(mEncoded);
+    parse_context ctx{in};
+    if (mSubitemOffsets.empty())
+    {
+        in.discard_buffered(mHead.encoded_length);
+    }
+    else
+    {
+        in.discard_buffered(mSubitemOffsets.back());
+        DPLX_TRY(dp::skip_item(ctx));
+    }
+
+    try
+    {
+        for (;;)
+        {
+            auto const offset = mEncoded.size() - in.size();
+            if (mHead.indefinite())
+            {
+                if (in.empty())
+                {
+                    return errc::end_of_stream;
+                }
+                if (*in.data() == std::byte{0xff})
+                {
+                    return errc::item_value_out_of_range;
+                }
+            }
+            mSubitemOffsets.push_back(offset);
+            if (mSubitemOffsets.size() > n)
+            {
+                return offset;
+            }
+            DPLX_TRY(dp::skip_item(ctx));
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+}
+
+} // namespace dplx::dp
@@ -0,0 +1,110 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <dplx/dp/concepts.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/items/type_code.hpp>
+#include <dplx/dp/streams/memory_input_stream.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * A lazy view of a CBOR item in contiguous memory.
+ *
+ * Only the item head is parsed upfront. Subitems are located on demand by
+ * skipping their preceding siblings with `skip_item()`; the located offsets
+ * are cached, i.e. each sibling is skipped at most once. Text and binary
+ * content is returned as a span into the original buffer.
+ *
+ * @warning The encoded buffer must outlive the view. The offset cache makes
+ * concurrent access to the same `item_ref` unsafe.
+ */
+class item_ref
+{
+    std::span<std::byte const> mEncoded;
+    item_head mHead{};
+    // the offsets of the subitems located so far
+    mutable std::vector<std::size_t> mSubitemOffsets;
+
+public:
+    item_ref() noexcept = default;
+
+    /**
+     * Parses the head of the item at the start of `encoded`; the buffer may
+     * extend beyond the item.
+     */
+    static auto parse(std::span<std::byte const> encoded) noexcept
+            -> result<item_ref>;
+
+    [[nodiscard]] auto head() const noexcept -> item_head const &
+    {
+        return mHead;
+    }
+    [[nodiscard]] auto type() const noexcept -> type_code
+    {
+        return mHead.type;
+    }
+    [[nodiscard]] auto value() const noexcept -> std::uint64_t
+    {
+        return mHead.value;
+    }
+    [[nodiscard]] auto indefinite() const noexcept -> bool
+    {
+        return mHead.indefinite();
+    }
+
+    /**
+     * Returns the content of a definite binary item.
+     */
+    [[nodiscard]] auto binary() const noexcept
+            -> result<std::span<std::byte const>>;
+    /**
+     * Returns the content of a definite text item.
+     */
+    [[nodiscard]] auto text() const noexcept -> result<std::u8string_view>;
+
+    /**
+     * Returns the i-th element of an array.
+     */
+    [[nodiscard]] auto at(std::size_t i) const noexcept -> result<item_ref>;
+    /**
+     * Returns the value of a map entry whose key is a definite text item equal
+     * to `key` or `errc::unknown_property`.
+     */
+    [[nodiscard]] auto operator[](std::u8string_view key) const noexcept
+            -> result<item_ref>;
+
+    /**
+     * Decodes the item with the codec of `T`.
+     */
+    template <typename T>
+        requires decodable<T>
+    auto decode(T &outValue) const noexcept -> result<void>
+    {
+        memory_input_stream in(mEncoded);
+        parse_context ctx{in};
+        return codec<T>::decode(ctx, outValue);
+    }
+
+private:
+    auto string_content(type_code expectedType) const noexcept
+            -> result<std::span<std::byte const>>;
+    auto locate_subitem(std::size_t n) const noexcept -> result<std::size_t>;
+};
+
+} // namespace dplx::dp
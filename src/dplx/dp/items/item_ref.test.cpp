@@ -0,0 +1,89 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/item_ref.hpp"
+
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("item_ref should navigate lazily")
+{
+    // {"a": [1, h'0203', [_ 4]], "bc": "de", 5: 6}
+    std::array const encoded{
+            std::byte{0xa3}, std::byte{0x61}, std::byte{0x61},
+            std::byte{0x83}, std::byte{0x01}, std::byte{0x42},
+            std::byte{0x02}, std::byte{0x03}, std::byte{0x9f},
+            std::byte{0x04}, std::byte{0xff}, std::byte{0x62},
+            std::byte{0x62}, std::byte{0x63}, std::byte{0x62},
+            std::byte{0x64}, std::byte{0x65}, std::byte{0x05},
+            std::byte{0x06}};
+
+    auto parseRx = dp::item_ref::parse(encoded);
+    REQUIRE(parseRx);
+    auto const &subject = parseRx.assume_value();
+    CHECK(subject.type() == dp::type_code::map);
+    CHECK(subject.value() == 3U);
+
+    SECTION("map values by key")
+    {
+        auto const bc = subject[u8"bc"];
+        REQUIRE(bc);
+        CHECK(bc.assume_value().text().value() == u8"de");
+
+        CHECK(subject[u8"x"].error() == dp::errc::unknown_property);
+        CHECK(subject.at(0U).error() == dp::errc::item_type_mismatch);
+    }
+    SECTION("array elements by index")
+    {
+        auto const a = subject[u8"a"];
+        REQUIRE(a);
+        auto const &array = a.assume_value();
+
+        auto const binary = array.at(1U);
+        REQUIRE(binary);
+        auto const content = binary.assume_value().binary();
+        REQUIRE(content);
+        CHECK(content.assume_value().data() == encoded.data() + 6);
+        CHECK(content.assume_value().size() == 2U);
+
+        auto const first = array.at(0U);
+        REQUIRE(first);
+        int value{};
+        REQUIRE(first.assume_value().decode(value));
+        CHECK(value == 1);
+
+        auto const nested = array.at(2U);
+        REQUIRE(nested);
+        CHECK(nested.assume_value().indefinite());
+        auto const four = nested.assume_value().at(0U);
+        REQUIRE(four);
+        CHECK(four.assume_value().value() == 4U);
+        CHECK(nested.assume_value().at(1U).error()
+              == dp::errc::item_value_out_of_range);
+
+        CHECK(array.at(3U).error() == dp::errc::item_value_out_of_range);
+    }
+}
+
+TEST_CASE("item_ref should reject truncated content")
+{
+    std::array const encoded{std::byte{0x43}, std::byte{0x01}};
+    auto parseRx = dp::item_ref::parse(encoded);
+    REQUIRE(parseRx);
+    CHECK(parseRx.assume_value().binary().error() == dp::errc::end_of_stream);
+    CHECK(parseRx.assume_value().text().error()
+          == dp::errc::item_type_mismatch);
+}
+
+} // namespace dp_tests
@@ -0,0 +1,283 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/item_tape.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <boost/container/small_vector.hpp>
+
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/streams/memory_input_stream.hpp>
+
+namespace dplx::dp
+{
+
+namespace
+{
+
+struct open_item
+{
+    std::uint32_t index;
+    // the number of remaining subitems of a definite container or the
+    // number of parsed subitems of an indefinite container
+    std::uint64_t count;
+    bool indefinite;
+};
+
+auto skip_string_chunks(parse_context &ctx, type_code const type) noexcept
+        -> result<void>
+{
+    for (;;)
+    {
+        DPLX_TRY(item_head const &chunk, dp::parse_item_head(ctx));
+        if (chunk.is_special_break())
+        {
+            return outcome::success();
+        }
+        if (chunk.type != type || chunk.indefinite())
+        {
+            return errc::invalid_indefinite_subitem;
+        }
+        DPLX_TRY(ctx.in.discard_input(chunk.value));
+    }
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+auto item_tape::build(std::span<std::byte const> const encoded) noexcept
+        -> result<item_tape>
+{
+    constexpr std::size_t numStackItems = 64;
+
+    memory_input_stream in(encoded);
+    parse_context ctx{in};
+
+    item_tape tape;
+    boost::container::small_vector<open_item, numStackItems> stack;
+    try
+    {
+        // a rough guess which avoids most reallocations for small items
+        tape.mEntries.reserve(std::min<std::size_t>(encoded.size(), 1024U));
+
+        auto const position = [&]() noexcept -> std::uint64_t {
+            return encoded.size() - in.size();
+        };
+
+        // closes the current item and all containers completed by it;
+        // returns true if the top level item has been completed
+        auto const completeItem = [&]() noexcept {
+            while (!stack.empty())
+            {
+                auto &top = stack.back();
+                if (top.indefinite)
+                {
+                    top.count += 1U;
+                    return false;
+                }
+                if (--top.count != 0U)
+                {
+                    return false;
+                }
+                tape.mEntries[top.index].next
+                        = static_cast<std::uint32_t>(tape.mEntries.size());
+                tape.mEntries[top.index].end = position();
+                stack.pop_back();
+            }
+            return true;
+        };
+
+        for (;;)
+        {
+            auto const offset = position();
+            DPLX_TRY(item_head const &head, dp::parse_item_head(ctx));
+
+            if (head.is_special_break())
+            {
+                if (stack.empty() || !stack.back().indefinite
+                    // an odd number of items in a map
+                    || (tape.mEntries[stack.back().index].type == type_code::map
+                        && (stack.back().count & 1U) != 0U))
+                {
+                    return errc::item_type_mismatch;
+                }
+                tape.mEntries[stack.back().index].next
+                        = static_cast<std::uint32_t>(tape.mEntries.size());
+                tape.mEntries[stack.back().index].end = position();
+                stack.pop_back();
+                if (completeItem())
+                {
+                    break;
+                }
+                continue;
+            }
+
+            if (tape.mEntries.size() >= UINT32_MAX || stack.size() > max_depth)
+                [[unlikely]]
+            {
+                return errc::item_value_out_of_range;
+            }
+            auto const index = static_cast<std::uint32_t>(tape.mEntries.size());
+            tape.mEntries.push_back(tape_entry{
+                    .offset = offset,
+                    .end = offset,
+                    .value = head.value,
+                    .next = index + 1U,
+                    .depth = static_cast<std::uint16_t>(stack.size()),
+                    .type = head.type,
+                    .head_info = static_cast<std::uint8_t>(
+                            head.encoded_length
+                            | (head.indefinite() ? tape_entry::indefinite_flag
+                                                 : 0U)),
+            });
+
+            // completes an item without subitems
+            auto const completeLeaf = [&]() noexcept {
+                tape.mEntries[index].end = position();
+                return completeItem();
+            };
+
+            bool completed = false;
+            switch (head.type)
+            {
+            case type_code::posint:
+            case type_code::negint:
+            case type_code::special:
+                completed = completeLeaf();
+                break;
+
+            case type_code::binary:
+            case type_code::text:
+                if (head.indefinite())
+                {
+                    DPLX_TRY(skip_string_chunks(ctx, head.type));
+                }
+                else
+                {
+                    DPLX_TRY(in.discard_input(head.value));
+                }
+                completed = completeLeaf();
+                break;
+
+            case type_code::array:
+            case type_code::map:
+                if (head.indefinite())
+                {
+                    stack.push_back(open_item{index, 0U, true});
+                }
+                else if (head.value == 0U)
+                {
+                    completed = completeLeaf();
+                }
+                else if (head.type == type_code::map
+                         && head.value > UINT64_MAX / 2U)
+                {
+                    return errc::item_value_out_of_range;
+                }
+                else
+                {
+                    stack.push_back(open_item{
+                            index,
+                            head.type == type_code::map ? head.value * 2U
+                                                        : head.value,
+                            false});
+                }
+                break;
+
+            case type_code::tag:
+                stack.push_back(open_item{index, 1U, false});
+                break;
+
+            default:
+                return errc::invalid_additional_information;
+            }
+            if (completed)
+            {
+                break;
+            }
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+
+    tape.mEncoded = encoded.first(encoded.size() - in.size());
+    return tape;
+}
+
+auto item_tape::encoded(std::size_t const index) const noexcept
+        -> std::span<std::byte const>
+{
+    auto const &entry = mEntries[index];
+    return mEncoded.subspan(static_cast<std::size_t>(entry.offset),
+                            static_cast<std::size_t>(entry.end - entry.offset));
+}
+
+auto item_tape::string_content(std::size_t const index) const noexcept
+        -> std::span<std::byte const>
+{
+    auto const &entry = mEntries[index];
+    if ((entry.type != type_code::binary && entry.type != type_code::text)
+        || entry.indefinite())
+    {
+        return {};
+    }
+    return mEncoded.subspan(
+            static_cast<std::size_t>(entry.offset + entry.head_size()),
+            static_cast<std::size_t>(entry.value));
+}
+
+auto item_tape::subitem(std::size_t const index,
+                        std::uint64_t n) const noexcept -> std::size_t
+{
+    auto const &container = mEntries[index];
+    if (container.type != type_code::array && container.type != type_code::map
+        && container.type != type_code::tag)
+    {
+        return mEntries.size();
+    }
+    std::size_t i = index + 1U;
+    for (; n > 0U && i < container.next; --n)
+    {
+        i = mEntries[i].next;
+    }
+    return i < container.next ? i : mEntries.size();
+}
+
+auto item_tape::find(std::size_t const mapIndex,
+                     std::u8string_view const key) const noexcept
+        -> std::size_t
+{
+    auto const &map = mEntries[mapIndex];
+    if (map.type != type_code::map)
+    {
+        return mEntries.size();
+    }
+    for (std::size_t i = mapIndex + 1U; i < map.next;)
+    {
+        auto const valueIndex = static_cast<std::size_t>(mEntries[i].next);
+        if (mEntries[i].type == type_code::text)
+        {
+            auto const content = string_content(i);
+            if (content.size() == key.size()
+                && (key.empty()
+                    || std::memcmp(content.data(), key.data(), key.size())
+                               == 0))
+            {
+                return valueIndex;
+            }
+        }
+        i = mEntries[valueIndex].next;
+    }
+    return mEntries.size();
+}
+
+} // namespace dplx::dp
@@ -0,0 +1,129 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/items/type_code.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * Describes a single item of an `item_tape`.
+ */
+struct tape_entry
+{
+    static constexpr std::uint8_t indefinite_flag = 0b1000'0000U;
+
+    /// the offset of the item head
+    std::uint64_t offset;
+    /// the offset following the item and its subitems (including the break
+    /// of an indefinite container)
+    std::uint64_t end;
+    /// the item head value, i.e. the integer value, the string byte size,
+    /// the number of array elements or map pairs, the tag or special value
+    std::uint64_t value;
+    /// the index of the first entry following the item and its subitems
+    std::uint32_t next;
+    std::uint16_t depth;
+    type_code type;
+    std::uint8_t head_info;
+
+    [[nodiscard]] constexpr auto indefinite() const noexcept -> bool
+    {
+        return (head_info & indefinite_flag) != 0U;
+    }
+    [[nodiscard]] constexpr auto head_size() const noexcept -> unsigned
+    {
+        return head_info & static_cast<std::uint8_t>(~indefinite_flag);
+    }
+};
+static_assert(sizeof(tape_entry) == 32U);
+
+/**
+ * A structural index of a CBOR item in contiguous memory.
+ *
+ * `build()` parses the item once and records every (sub)item in document
+ * order together with its nesting depth and the index of the entry
+ * following its subitems. Afterwards skipping an item is a single jump and
+ * arrays and maps can be navigated without parsing any item heads. The
+ * chunks of indefinite strings are not recorded.
+ *
+ * @warning The tape refers to the encoded buffer which must outlive it.
+ */
+class item_tape
+{
+    std::span<std::byte const> mEncoded;
+    std::vector<tape_entry> mEntries;
+
+public:
+    static constexpr std::size_t max_depth = UINT16_MAX;
+
+    item_tape() noexcept = default;
+
+    /**
+     * Indexes the first item of `encoded`.
+     */
+    static auto build(std::span<std::byte const> encoded) noexcept
+            -> result<item_tape>;
+
+    [[nodiscard]] auto entries() const noexcept
+            -> std::span<tape_entry const>
+    {
+        return mEntries;
+    }
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return mEntries.size();
+    }
+    [[nodiscard]] auto operator[](std::size_t const index) const noexcept
+            -> tape_entry const &
+    {
+        return mEntries[index];
+    }
+
+    /**
+     * Returns the index of the next sibling, i.e. skips the item.
+     */
+    [[nodiscard]] auto skip(std::size_t const index) const noexcept
+            -> std::size_t
+    {
+        return mEntries[index].next;
+    }
+    /**
+     * Returns the encoded bytes of the item including its subitems.
+     */
+    [[nodiscard]] auto encoded(std::size_t index) const noexcept
+            -> std::span<std::byte const>;
+    /**
+     * Returns the content of a definite binary or text item.
+     */
+    [[nodiscard]] auto string_content(std::size_t index) const noexcept
+            -> std::span<std::byte const>;
+
+    /**
+     * Returns the index of the n-th subitem of an array, map (keys and
+     * values count separately) or tag or `size()` if there is none.
+     */
+    [[nodiscard]] auto subitem(std::size_t index,
+                               std::uint64_t n) const noexcept -> std::size_t;
+    /**
+     * Returns the index of the value whose key is a definite text item equal
+     * to `key` or `size()` if the map contains no such key.
+     */
+    [[nodiscard]] auto find(std::size_t mapIndex,
+                            std::u8string_view key) const noexcept
+            -> std::size_t;
+};
+
+} // namespace dplx::dp
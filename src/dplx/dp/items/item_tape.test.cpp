@@ -0,0 +1,155 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/item_tape.hpp"
+
+#include <array>
+#include <span>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "blob_matcher.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("item_tape should index every subitem")
+{
+    // {"a": [1, h'0203'], "bc": (_ "d", "e"), "f": 1(-1)}
+    std::array const encoded{
+            std::byte{0xa3}, std::byte{0x61}, std::byte{0x61},
+            std::byte{0x82}, std::byte{0x01}, std::byte{0x42},
+            std::byte{0x02}, std::byte{0x03}, std::byte{0x62},
+            std::byte{0x62}, std::byte{0x63}, std::byte{0x7f},
+            std::byte{0x61}, std::byte{0x64}, std::byte{0x61},
+            std::byte{0x65}, std::byte{0xff}, std::byte{0x61},
+            std::byte{0x66}, std::byte{0xc1}, std::byte{0x20},
+            // trailing garbage which doesn't belong to the item
+            std::byte{0xff}};
+
+    auto buildRx = dp::item_tape::build(encoded);
+    REQUIRE(buildRx);
+    auto const &subject = buildRx.assume_value();
+
+    REQUIRE(subject.size() == 10U);
+    CHECK(subject[0].type == dp::type_code::map);
+    CHECK(subject[0].value == 3U);
+    CHECK(subject[0].next == 10U);
+    CHECK(subject[3].type == dp::type_code::posint);
+    CHECK(subject[3].depth == 2U);
+    CHECK(subject[6].indefinite());
+    CHECK(subject[6].next == 7U);
+    CHECK(subject[9].type == dp::type_code::negint);
+    CHECK(subject[9].depth == 2U);
+
+    CHECK(subject.encoded(0U).size() == encoded.size() - 1U);
+
+    SECTION("and skip items with a single jump")
+    {
+        CHECK(subject.skip(2U) == 5U);
+        CHECK(subject.skip(5U) == 6U);
+        CHECK(subject.skip(6U) == 7U);
+    }
+    SECTION("and find map values by key")
+    {
+        auto const arrayIndex = subject.find(0U, u8"a");
+        REQUIRE(arrayIndex == 2U);
+        auto const binaryIndex = subject.subitem(arrayIndex, 1U);
+        REQUIRE(binaryIndex == 4U);
+        auto const content = subject.string_content(binaryIndex);
+        std::array const expectedContent{std::byte{0x02}, std::byte{0x03}};
+        CHECK_BLOB_EQ(content, expectedContent);
+
+        auto const stringIndex = subject.find(0U, u8"bc");
+        CHECK(stringIndex == 6U);
+        CHECK(subject.string_content(stringIndex).empty());
+
+        CHECK(subject.find(0U, u8"x") == subject.size());
+        CHECK(subject.subitem(arrayIndex, 2U) == subject.size());
+        CHECK(subject.subitem(subject.find(0U, u8"f"), 0U) == 9U);
+    }
+    SECTION("and project subitems")
+    {
+        auto const projected = subject.encoded(subject.find(0U, u8"a"));
+        auto const expected = std::span(encoded).subspan(3U, 5U);
+        CHECK_BLOB_EQ(projected, expected);
+    }
+}
+
+TEST_CASE("item_tape should project the last subitem of indefinite items")
+{
+    SECTION("of an indefinite array")
+    {
+        // [_ 1, 2]
+        std::array const encoded{std::byte{0x9f}, std::byte{0x01},
+                                 std::byte{0x02}, std::byte{0xff}};
+        auto buildRx = dp::item_tape::build(encoded);
+        REQUIRE(buildRx);
+        auto const &subject = buildRx.assume_value();
+
+        auto const projected = subject.encoded(2U);
+        auto const expected = std::span(encoded).subspan(2U, 1U);
+        CHECK_BLOB_EQ(projected, expected);
+        CHECK(subject.encoded(0U).size() == encoded.size());
+    }
+    SECTION("of a nested indefinite array")
+    {
+        // [[_ 1], 5]
+        std::array const encoded{std::byte{0x82}, std::byte{0x9f},
+                                 std::byte{0x01}, std::byte{0xff},
+                                 std::byte{0x05}};
+        auto buildRx = dp::item_tape::build(encoded);
+        REQUIRE(buildRx);
+        auto const &subject = buildRx.assume_value();
+
+        auto const last = subject.encoded(2U);
+        auto const expectedLast = std::span(encoded).subspan(2U, 1U);
+        CHECK_BLOB_EQ(last, expectedLast);
+        auto const inner = subject.encoded(1U);
+        auto const expectedInner = std::span(encoded).subspan(1U, 3U);
+        CHECK_BLOB_EQ(inner, expectedInner);
+    }
+    SECTION("of an indefinite map")
+    {
+        // {_ 1: [2], 3: 4}
+        std::array const encoded{std::byte{0xbf}, std::byte{0x01},
+                                 std::byte{0x81}, std::byte{0x02},
+                                 std::byte{0x03}, std::byte{0x04},
+                                 std::byte{0xff}};
+        auto buildRx = dp::item_tape::build(encoded);
+        REQUIRE(buildRx);
+        auto const &subject = buildRx.assume_value();
+        REQUIRE(subject.size() == 6U);
+
+        auto const value = subject.encoded(5U);
+        auto const expectedValue = std::span(encoded).subspan(5U, 1U);
+        CHECK_BLOB_EQ(value, expectedValue);
+        auto const array = subject.encoded(2U);
+        auto const expectedArray = std::span(encoded).subspan(2U, 2U);
+        CHECK_BLOB_EQ(array, expectedArray);
+        CHECK(subject.encoded(0U).size() == encoded.size());
+    }
+}
+
+TEST_CASE("item_tape should reject malformed items")
+{
+    SECTION("a truncated array")
+    {
+        std::array const encoded{std::byte{0x82}, std::byte{0x01}};
+        CHECK(dp::item_tape::build(encoded).error()
+              == dp::errc::end_of_stream);
+    }
+    SECTION("a break after a map key")
+    {
+        std::array const encoded{std::byte{0xbf}, std::byte{0x01},
+                                 std::byte{0xff}};
+        CHECK(dp::item_tape::build(encoded).error()
+              == dp::errc::item_type_mismatch);
+    }
+}
+
+} // namespace dp_tests
@@ -22,6 +22,15 @@ struct parse_context
     input_buffer &in;
     state_store states;
     link_store links;
+    /// whether text items must be well-formed UTF-8 as required by RFC 8949;
+    /// if set `parse_text()` and the string codecs fail with
+    /// `errc::invalid_utf8` otherwise
+    bool validate_utf8{false};
+    /// memory for copies of content which the borrowing parse functions
+    /// can't view in place, e.g. input which isn't resident; the copies are
+    /// never deallocated, i.e. this should be an arena. If unset these
+    /// functions fail with `errc::input_not_borrowable` instead.
+    std::pmr::memory_resource *borrow_arena{nullptr};
 
     explicit parse_context(
             input_buffer &inStreamBuffer,
@@ -209,11 +209,11 @@ parse_item_head_safe(parse_context &ctx) noexcept -> result<item_head>
 template <bool discard>
 inline auto parse_item_head(parse_context &ctx) noexcept -> result<item_head>
 {
-    if (ctx.in.empty())
+    if (ctx.in.empty()) [[unlikely]]
     {
         DPLX_TRY(ctx.in.require_input(1U));
     }
-    if (ctx.in.size() >= detail::var_uint_max_size)
+    if (ctx.in.size() >= detail::var_uint_max_size) [[likely]]
     {
         return detail::do_parse_item_head<true, discard>(ctx);
     }
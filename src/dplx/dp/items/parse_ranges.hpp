@@ -8,14 +8,24 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
 #include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
 
 #include <dplx/dp/cpos/container.hpp>
+#include <dplx/dp/detail/bit.hpp>
+#include <dplx/dp/detail/utf8.hpp>
 #include <dplx/dp/disappointment.hpp>
 #include <dplx/dp/fwd.hpp>
 #include <dplx/dp/items/parse_context.hpp>
 #include <dplx/dp/items/parse_core.hpp>
 #include <dplx/dp/items/type_code.hpp>
+#include <dplx/dp/streams/input_buffer.hpp>
 
 namespace dplx::dp
 {
@@ -34,6 +44,20 @@ inline auto parse_blob_indefinite(parse_context &ctx,
                                   type_code expectedType) noexcept
         -> result<std::size_t>;
 
+// validates the freshly read content while it is still cached
+inline auto validate_blob(parse_context const &ctx,
+                          type_code const type,
+                          std::byte const *const content,
+                          std::size_t const size) noexcept -> result<void>
+{
+    if (type == type_code::text && ctx.validate_utf8
+        && !detail::is_valid_utf8(content, size))
+    {
+        return errc::invalid_utf8;
+    }
+    return outcome::success();
+}
+
 template <bool AllowIndefiniteEncoding, typename Container>
 inline auto parse_blob(parse_context &ctx,
                        Container &dest,
@@ -80,7 +104,9 @@ inline auto parse_blob(parse_context &ctx,
     auto const memory = std::ranges::data(dest);
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    DPLX_TRY(ctx.in.bulk_read(reinterpret_cast<std::byte *>(memory), size));
+    auto *const bytes = reinterpret_cast<std::byte *>(memory);
+    DPLX_TRY(ctx.in.bulk_read(bytes, size));
+    DPLX_TRY(detail::validate_blob(ctx, expectedType, bytes, size));
     return size;
 }
 
@@ -127,10 +153,12 @@ inline auto parse_blob_indefinite(parse_context &ctx,
 
         // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
         // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        DPLX_TRY(ctx.in.bulk_read(reinterpret_cast<std::byte *>(memory) + size,
-                                  chunkSize));
+        auto *const chunk = reinterpret_cast<std::byte *>(memory) + size;
         // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        DPLX_TRY(ctx.in.bulk_read(chunk, chunkSize));
+        // RFC 8949 requires every chunk to be well-formed on its own
+        DPLX_TRY(detail::validate_blob(ctx, expectedType, chunk, chunkSize));
 
         size = static_cast<std::size_t>(newSize);
     }
@@ -138,6 +166,84 @@ inline auto parse_blob_indefinite(parse_context &ctx,
     return size;
 }
 
+// whether views into the buffered input stay valid, i.e. all remaining input
+// is buffered and therefore the stream won't refill or replace its buffer
+inline auto input_is_resident(input_buffer const &in) noexcept -> bool
+{
+    return in.size() == in.input_size();
+}
+
+// copies the next `size` bytes of content which can't be viewed in place
+// into the borrow arena which owns the copy afterwards
+inline auto copy_borrowed(parse_context &ctx,
+                          std::size_t const size,
+                          std::size_t const alignment) noexcept
+        -> result<std::byte *>
+{
+    if (ctx.borrow_arena == nullptr)
+    {
+        return errc::input_not_borrowable;
+    }
+    void *copy = nullptr;
+    try
+    {
+        copy = ctx.borrow_arena->allocate(size, alignment);
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+    if (result<void> readRx = ctx.in.bulk_read(static_cast<std::byte *>(copy),
+                                               size);
+        readRx.has_failure())
+    {
+        ctx.borrow_arena->deallocate(copy, size, alignment);
+        return static_cast<result<void> &&>(readRx).as_failure();
+    }
+    return static_cast<std::byte *>(copy);
+}
+
+inline auto parse_blob_borrowed(parse_context &ctx,
+                                type_code const expectedType) noexcept
+        -> result<std::span<std::byte const>>
+{
+    DPLX_TRY(item_head const &head, dp::parse_item_head(ctx));
+
+    if (head.type != expectedType)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (head.indefinite())
+    {
+        // the chunks are not contiguous
+        return errc::indefinite_item;
+    }
+    if (ctx.in.input_size() < head.value)
+    {
+        return errc::missing_data;
+    }
+
+    auto const size = static_cast<std::size_t>(head.value);
+    if (!detail::input_is_resident(ctx.in) && size > 0U)
+    {
+        // the buffer may be replaced by the next refill
+        DPLX_TRY(std::byte *const copy,
+                 detail::copy_borrowed(ctx, size, alignof(std::byte)));
+        if (result<void> validateRx
+            = detail::validate_blob(ctx, expectedType, copy, size);
+            validateRx.has_failure())
+        {
+            ctx.borrow_arena->deallocate(copy, size, alignof(std::byte));
+            return static_cast<result<void> &&>(validateRx).as_failure();
+        }
+        return std::span<std::byte const>(copy, size);
+    }
+    std::span<std::byte const> const content(ctx.in.data(), size);
+    DPLX_TRY(detail::validate_blob(ctx, expectedType, content.data(), size));
+    ctx.in.discard_buffered(size);
+    return content;
+}
+
 } // namespace detail
 
 // clang-format off
@@ -190,6 +296,34 @@ inline auto parse_text_finite(parse_context &ctx,
     return detail::parse_blob<false>(ctx, dest, maxSize, type_code::text);
 }
 
+/**
+ * Returns a view of the content of a definite binary item which refers to the
+ * input buffer, i.e. nothing is copied. This requires all remaining input to
+ * be buffered, e.g. a `memory_input_stream`, and the view is valid as long
+ * as its memory. Otherwise the stream may replace its buffer, therefore the
+ * content is copied into `ctx.borrow_arena` which owns the copy. If no arena
+ * has been supplied, this fails with `errc::input_not_borrowable`.
+ * Indefinite items are rejected with `errc::indefinite_item`.
+ */
+inline auto parse_binary_borrowed(parse_context &ctx) noexcept
+        -> result<std::span<std::byte const>>
+{
+    return detail::parse_blob_borrowed(ctx, type_code::binary);
+}
+/**
+ * Returns a view of the content of a definite text item which refers to the
+ * input buffer, see `parse_binary_borrowed()`.
+ */
+inline auto parse_text_borrowed(parse_context &ctx) noexcept
+        -> result<std::u8string_view>
+{
+    DPLX_TRY(std::span<std::byte const> const content,
+             detail::parse_blob_borrowed(ctx, type_code::text));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return std::u8string_view(reinterpret_cast<char8_t const *>(content.data()),
+                              content.size());
+}
+
 } // namespace dplx::dp
 
 namespace dplx::dp
@@ -404,4 +538,194 @@ inline auto parse_map_finite(parse_context &ctx,
             static_cast<DecodeElementFn &&>(decodeElement));
 }
 
+namespace detail
+{
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// decodes integer items from the buffered bytes [it, end) until either
+// `size` elements have been written, the buffer runs dry or an item doesn't
+// decode into a T. The latter two are left to `parse_integer()` which will
+// either refill the buffer or report the appropriate error. Returns the
+// number of elements written and advances `it` past them.
+template <encodable_int T>
+inline auto decode_buffered_integers(std::byte const *&it,
+                                     std::byte const *const end,
+                                     T *const out,
+                                     std::size_t const size) noexcept
+        -> std::size_t
+{
+    constexpr std::uint64_t lanes = 0x0101'0101'0101'0101U;
+    // signed targets accept major types 0 and 1, unsigned ones only 0
+    constexpr unsigned indicatorMajorMask = std::is_signed_v<T> ? 0xc0U : 0xe0U;
+    constexpr std::uint64_t majorMask = indicatorMajorMask * lanes;
+    constexpr std::uint64_t infoMask = 0x1fU * lanes;
+    // adding 8 to an additional information value [0..31] sets bit 5 iff
+    // the value exceeds inline_value_max, i.e. a payload follows
+    constexpr std::uint64_t infoBias = 0x08U * lanes;
+    constexpr std::uint64_t payloadFlags = 0x20U * lanes;
+    constexpr auto maxValue = static_cast<std::make_unsigned_t<T>>(
+            std::numeric_limits<T>::max());
+
+    std::size_t i = 0U;
+    while (i < size)
+    {
+        // classify a block of initial bytes at once; a block consisting
+        // solely of inline values (which fit every T) is decoded without any
+        // further branches
+        if (size - i >= sizeof(std::uint64_t)
+            && static_cast<std::size_t>(end - it) >= sizeof(std::uint64_t))
+        {
+            std::uint64_t block; // NOLINT(cppcoreguidelines-init-variables)
+            std::memcpy(&block, it, sizeof(block));
+            if ((block & majorMask) == 0U
+                && (((block & infoMask) + infoBias) & payloadFlags) == 0U)
+            {
+                for (std::size_t j = 0U; j < sizeof(std::uint64_t); ++j)
+                {
+                    auto const indicator = static_cast<unsigned>(it[j]);
+                    // 0 or ~0
+                    auto const xorpad = static_cast<T>(std::uint64_t{0U}
+                                                       - (indicator >> 5));
+                    out[i + j] = static_cast<T>(
+                            static_cast<T>(indicator & item_inline_info_mask)
+                            ^ xorpad);
+                }
+                it += sizeof(std::uint64_t);
+                i += sizeof(std::uint64_t);
+                continue;
+            }
+        }
+
+        if (it == end)
+        {
+            break;
+        }
+        auto const indicator = static_cast<unsigned>(*it);
+        if ((indicator & indicatorMajorMask) != 0U)
+        {
+            break;
+        }
+        auto const info = indicator & item_inline_info_mask;
+        std::uint64_t value = info;
+        std::size_t encodedLength = 1U;
+        if (info > inline_value_max)
+        {
+            if (info > item_var_int_coding_threshold)
+            {
+                break;
+            }
+            encodedLength += std::size_t{1U}
+                             << (info - (inline_value_max + 1U));
+            if (static_cast<std::size_t>(end - it) < encodedLength)
+            {
+                break;
+            }
+            switch (encodedLength)
+            {
+            case 2U:
+                value = static_cast<std::uint64_t>(it[1]);
+                break;
+            case 3U:
+                value = detail::load<std::uint16_t>(it + 1);
+                break;
+            case 5U:
+                value = detail::load<std::uint32_t>(it + 1);
+                break;
+            default:
+                value = detail::load<std::uint64_t>(it + 1);
+                break;
+            }
+            if (value > maxValue)
+            {
+                break;
+            }
+        }
+
+        auto const xorpad = std::uint64_t{0U} - (indicator >> 5);
+        out[i] = static_cast<T>(value ^ xorpad);
+        it += encodedLength;
+        i += 1U;
+    }
+    return i;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+
+} // namespace detail
+
+// clang-format off
+template <typename Container>
+concept integer_array_container
+    = std::ranges::contiguous_range<Container>
+    && container_traits<Container>::resize
+    && detail::encodable_int<std::ranges::range_value_t<Container>>;
+// clang-format on
+
+/**
+ * Parses an array of integers into the container. It yields the same results
+ * as `parse_array()` with `parse_integer()` for each element, but the
+ * elements of a definite array which are already buffered are decoded in
+ * bulk straight into the container storage.
+ */
+template <integer_array_container Container>
+inline auto parse_integer_array(parse_context &ctx,
+                                Container &dest,
+                                std::size_t const maxSize = SIZE_MAX) noexcept
+        -> result<std::size_t>
+{
+    using element_type = std::ranges::range_value_t<Container>;
+
+    DPLX_TRY(item_head const &head, dp::parse_item_head(ctx));
+    if (head.type != type_code::array)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (head.indefinite()) [[unlikely]]
+    {
+        return detail::parse_indefinite_array_like(
+                ctx, dest, maxSize,
+                [](parse_context &subCtx, Container &elements,
+                   std::size_t const i) noexcept -> result<void> {
+                    DPLX_TRY(container_resize(elements, i + 1U));
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    return dp::parse_integer(subCtx,
+                                             std::ranges::data(elements)[i]);
+                });
+    }
+    if (ctx.in.input_size() < head.value)
+    {
+        // defend against amplification attacks exhausting main memory
+        return errc::missing_data;
+    }
+    if (head.value > maxSize)
+    {
+        return errc::item_value_out_of_range;
+    }
+
+    auto const numElements = static_cast<std::size_t>(head.value);
+    DPLX_TRY(container_resize_for_overwrite(dest, numElements));
+    element_type *const elements = std::ranges::data(dest);
+
+    for (std::size_t i = 0U; i < numElements;)
+    {
+        std::byte const *const buffered = ctx.in.data();
+        std::byte const *it = buffered;
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        i += detail::decode_buffered_integers<element_type>(
+                it, buffered + ctx.in.size(), elements + i, numElements - i);
+        ctx.in.discard_buffered(static_cast<std::size_t>(it - buffered));
+        if (i < numElements)
+        {
+            // refills the buffer or reports the error
+            DPLX_TRY(dp::parse_integer(ctx, elements[i]));
+            i += 1U;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return numElements;
+}
+
 } // namespace dplx::dp
@@ -8,7 +8,13 @@
 #include "dplx/dp/items/parse_ranges.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
 #include <numeric>
+#include <span>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -18,6 +24,10 @@
 #include "blob_matcher.hpp"
 #include "dplx/dp/api.hpp"
 #include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "dplx/dp/streams/memory_input_stream.hpp"
+#include "dplx/dp/streams/segmented_input_stream.hpp"
 #include "item_sample_rt.hpp"
 #include "test_input_stream.hpp"
 #include "test_utils.hpp"
@@ -143,6 +153,130 @@ TEST_CASE("parse a short indefinite text")
     }
 }
 
+TEST_CASE("parse_text should validate UTF-8 on request")
+{
+    std::string value;
+
+    SECTION("a well-formed definite text")
+    {
+        std::array const encoded{std::byte{0x62}, std::byte{0xc3},
+                                 std::byte{0xa4}};
+        simple_test_parse_context ctx(encoded);
+        ctx.as_parse_context().validate_utf8 = true;
+
+        REQUIRE(dp::parse_text(ctx.as_parse_context(), value));
+        CHECK(value == "\xc3\xa4");
+    }
+    SECTION("an ill-formed definite text")
+    {
+        std::array const encoded{std::byte{0x62}, std::byte{0xc3},
+                                 std::byte{0x28}};
+        simple_test_parse_context ctx(encoded);
+
+        SECTION("is accepted by default")
+        {
+            CHECK(dp::parse_text(ctx.as_parse_context(), value));
+        }
+        SECTION("is rejected if validating")
+        {
+            ctx.as_parse_context().validate_utf8 = true;
+            CHECK(dp::parse_text(ctx.as_parse_context(), value).error()
+                  == dp::errc::invalid_utf8);
+        }
+    }
+    SECTION("a code point split across chunks")
+    {
+        // (_ "\xc3", "\xa4")
+        std::array const encoded{std::byte{0x7f}, std::byte{0x61},
+                                 std::byte{0xc3}, std::byte{0x61},
+                                 std::byte{0xa4}, std::byte{0xff}};
+        simple_test_parse_context ctx(encoded);
+        ctx.as_parse_context().validate_utf8 = true;
+
+        CHECK(dp::parse_text(ctx.as_parse_context(), value).error()
+              == dp::errc::invalid_utf8);
+    }
+}
+
+TEST_CASE("parse_binary_borrowed should return a view into the input")
+{
+    SECTION("for a definite binary")
+    {
+        std::array const encoded{std::byte{0x42}, std::byte{0x01},
+                                 std::byte{0x02}};
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in};
+
+        auto parseRx = dp::parse_binary_borrowed(ctx);
+        REQUIRE(parseRx);
+        CHECK(parseRx.assume_value().data() == encoded.data() + 1);
+        CHECK(parseRx.assume_value().size() == 2U);
+        CHECK(in.empty());
+    }
+    SECTION("but not for an indefinite binary")
+    {
+        std::array const encoded{std::byte{0x5f}, std::byte{0x41},
+                                 std::byte{0x01}, std::byte{0xff}};
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in};
+
+        CHECK(dp::parse_binary_borrowed(ctx).error()
+              == dp::errc::indefinite_item);
+    }
+    SECTION("but not for a text")
+    {
+        std::array const encoded{std::byte{0x61}, std::byte{0x61}};
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in};
+
+        CHECK(dp::parse_binary_borrowed(ctx).error()
+              == dp::errc::item_type_mismatch);
+    }
+}
+
+TEST_CASE("parse_binary_borrowed should copy input which isn't resident")
+{
+    // h'010203' split across two segments
+    std::array const first{std::byte{0x43}, std::byte{0x01}};
+    std::array const second{std::byte{0x02}, std::byte{0x03}};
+    std::array const segments{std::span<std::byte const>(first),
+                              std::span<std::byte const>(second)};
+    dp::segmented_input_stream in(segments);
+    dp::parse_context ctx{in};
+
+    SECTION("into the borrow arena")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        ctx.borrow_arena = &arena;
+
+        auto parseRx = dp::parse_binary_borrowed(ctx);
+        REQUIRE(parseRx);
+        auto const content = parseRx.assume_value();
+        std::array const expected{std::byte{0x01}, std::byte{0x02},
+                                  std::byte{0x03}};
+        CHECK_BLOB_EQ(content, expected);
+        CHECK(content.data() != first.data() + 1);
+        CHECK(in.input_size() == 0U);
+    }
+    SECTION("but fail without a borrow arena")
+    {
+        CHECK(dp::parse_binary_borrowed(ctx).error()
+              == dp::errc::input_not_borrowable);
+    }
+}
+
+TEST_CASE("parse_text_borrowed should return a view into the input")
+{
+    std::array const encoded{std::byte{0x62}, std::byte{0x61},
+                             std::byte{0x62}};
+    dp::memory_input_stream in(encoded);
+    dp::parse_context ctx{in};
+
+    auto parseRx = dp::parse_text_borrowed(ctx);
+    REQUIRE(parseRx);
+    CHECK(parseRx.assume_value() == u8"ab");
+}
+
 TEST_CASE("parse_array parses a finite array of integers into a vector")
 {
     item_sample_rt<std::vector<int>> const sample
@@ -212,6 +346,88 @@ TEST_CASE("parse_array parses an indefinite array of integers into a vector")
     }
 }
 
+TEST_CASE("parse_integer_array parses arrays of integers into a vector")
+{
+    item_sample_rt<std::vector<int>> const sample = GENERATE(
+            load_samples_from_yaml<std::vector<int>>("arrays.yaml",
+                                                     "int arrays"),
+            load_samples_from_yaml<std::vector<int>>("arrays.yaml",
+                                                     "indefinite int arrays"));
+    INFO(sample);
+
+    simple_test_parse_context ctx(sample.encoded_bytes());
+    std::vector<int> value;
+
+    auto parseRx = dp::parse_integer_array(ctx.as_parse_context(), value);
+
+    REQUIRE(parseRx);
+    CHECK(parseRx.assume_value() == sample.value.size());
+    CHECK(std::ranges::equal(value, sample.value));
+}
+
+TEST_CASE("parse_integer_array should decode every encoding width")
+{
+    std::vector<std::int64_t> sample(20U);
+    std::iota(sample.begin(), sample.end(), std::int64_t{-4});
+    for (std::int64_t const v :
+         {std::int64_t{24}, std::int64_t{-25}, std::int64_t{255},
+          std::int64_t{-256}, std::int64_t{256}, std::int64_t{-65'537},
+          std::int64_t{0x1'0000'0000}, std::numeric_limits<std::int64_t>::min(),
+          std::numeric_limits<std::int64_t>::max()})
+    {
+        sample.push_back(v);
+    }
+    sample.insert(sample.end(), 9U, std::int64_t{7});
+
+    dp::dynamic_memory_output_stream<> out;
+    REQUIRE(dp::encode(out, sample));
+    auto const encoded = std::span<std::byte const>(out.written());
+
+    SECTION("into a vector of int64")
+    {
+        simple_test_parse_context ctx(encoded);
+        std::vector<std::int64_t> value;
+
+        auto parseRx = dp::parse_integer_array(ctx.as_parse_context(), value);
+
+        REQUIRE(parseRx);
+        CHECK(std::ranges::equal(value, sample));
+        CHECK(ctx.stream.empty());
+    }
+    SECTION("and reject values out of range")
+    {
+        simple_test_parse_context ctx(encoded);
+        std::vector<std::int16_t> value;
+
+        CHECK(dp::parse_integer_array(ctx.as_parse_context(), value).error()
+              == dp::errc::item_value_out_of_range);
+    }
+    SECTION("and reject negative values for unsigned elements")
+    {
+        simple_test_parse_context ctx(encoded);
+        std::vector<std::uint64_t> value;
+
+        CHECK(dp::parse_integer_array(ctx.as_parse_context(), value).error()
+              == dp::errc::item_type_mismatch);
+    }
+}
+
+TEST_CASE("parse_integer_array should reject non integer elements")
+{
+    std::array const encoded{std::byte{0x8a}, std::byte{0x00},
+                             std::byte{0x01}, std::byte{0x02},
+                             std::byte{0x03}, std::byte{0x04},
+                             std::byte{0x05}, std::byte{0x06},
+                             std::byte{0x07}, std::byte{0xf6},
+                             std::byte{0x09}};
+
+    simple_test_parse_context ctx(encoded);
+    std::vector<unsigned> value;
+
+    CHECK(dp::parse_integer_array(ctx.as_parse_context(), value).error()
+          == dp::errc::item_type_mismatch);
+}
+
 TEST_CASE("parse_map parses a finite map of integers into a vector of pairs")
 {
     item_sample_rt<std::vector<std::pair<int, int>>> const sample
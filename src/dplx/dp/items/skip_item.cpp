@@ -8,10 +8,12 @@
 #include "dplx/dp/items/skip_item.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <new>
 
 #include <boost/container/small_vector.hpp>
 
+#include <dplx/dp/detail/bit.hpp>
 #include <dplx/dp/items/parse_context.hpp>
 #include <dplx/dp/items/parse_core.hpp>
 
@@ -57,6 +59,222 @@ static auto skip_binary_or_text(parse_context &ctx, item_head const &item)
     return outcome::success();
 }
 
+DPLX_ATTR_FORCE_INLINE static auto
+parse_contiguous_head(std::byte const *const encoded,
+                      std::size_t const available) noexcept -> result<item_head>
+{
+    auto const indicator = static_cast<std::uint8_t>(*encoded);
+    item_head head{
+            .type = static_cast<type_code>(indicator & item_type_mask),
+            .flags = item_head::flag::none,
+            .encoded_length = 1U,
+            .value = static_cast<std::uint64_t>(indicator
+                                                & item_inline_info_mask),
+    };
+    if (head.value <= inline_value_max)
+    {
+        return head;
+    }
+    if (head.value <= item_var_int_coding_threshold) [[likely]]
+    {
+        auto const sizeBytesPower
+                = static_cast<unsigned>(head.value) - (inline_value_max + 1U);
+        head.encoded_length = 1U + (1U << sizeBytesPower);
+        if (available < head.encoded_length)
+        {
+            return errc::end_of_stream;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::byte const *const payload = encoded + 1;
+        // NOLINTNEXTLINE(bugprone-switch-missing-default-case)
+        switch (sizeBytesPower)
+        {
+        case 0U:
+            head.value = static_cast<std::uint64_t>(*payload);
+            // encoding type 7 (special) values [0..32] with two bytes is
+            // forbidden as per RFC8949 section 3.3
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+            if (head.type == type_code::special && head.value < 0x20)
+                    [[unlikely]]
+            {
+                return errc::invalid_additional_information;
+            }
+            break;
+        case 1U:
+            head.value = detail::load<std::uint16_t>(payload);
+            break;
+        case 2U:
+            head.value = detail::load<std::uint32_t>(payload);
+            break;
+        case 3U:
+            head.value = detail::load<std::uint64_t>(payload);
+            break;
+        }
+        return head;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+    if (head.value == 31U
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+        && (static_cast<unsigned char>(head.type) & 0b110'00000U) != 0U
+        && head.type != type_code::tag)
+    {
+        head.make_indefinite();
+        return head;
+    }
+    return errc::invalid_additional_information;
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+auto measure_item(std::span<std::byte const> const buffer) noexcept
+        -> result<std::size_t>
+{
+    struct open_container
+    {
+        // the number of remaining subitems of a definite container or the
+        // number of parsed subitems of an indefinite container
+        std::uint64_t count;
+        bool indefinite;
+        bool map;
+    };
+    constexpr std::size_t numStackItems = 64;
+
+    boost::container::small_vector<open_container, numStackItems> stack;
+    std::size_t offset = 0U;
+    // a tag must be followed by another item, i.e. not by a break
+    bool tagged = false;
+    try
+    {
+        for (;;)
+        {
+            if (offset == buffer.size())
+            {
+                return errc::end_of_stream;
+            }
+            DPLX_TRY(item_head const head,
+                     detail::parse_contiguous_head(&buffer[offset],
+                                                   buffer.size() - offset));
+            offset += head.encoded_length;
+            auto const remaining = buffer.size() - offset;
+
+            switch (head.type)
+            {
+            case type_code::posint:
+            case type_code::negint:
+                break;
+
+            case type_code::special:
+                if (!head.indefinite())
+                {
+                    break;
+                }
+                // a special break closes the current indefinite container
+                if (tagged || stack.empty() || !stack.back().indefinite
+                    || (stack.back().map && (stack.back().count & 1U) != 0U))
+                {
+                    return errc::item_type_mismatch;
+                }
+                stack.pop_back();
+                break;
+
+            case type_code::binary:
+            case type_code::text:
+                if (!head.indefinite())
+                {
+                    if (remaining < head.value)
+                    {
+                        return errc::end_of_stream;
+                    }
+                    offset += static_cast<std::size_t>(head.value);
+                    break;
+                }
+                for (;;)
+                {
+                    if (offset == buffer.size())
+                    {
+                        return errc::end_of_stream;
+                    }
+                    DPLX_TRY(item_head const chunk,
+                             detail::parse_contiguous_head(
+                                     &buffer[offset], buffer.size() - offset));
+                    offset += chunk.encoded_length;
+                    if (chunk.is_special_break())
+                    {
+                        break;
+                    }
+                    if (chunk.type != head.type || chunk.indefinite())
+                    {
+                        return errc::invalid_indefinite_subitem;
+                    }
+                    if (buffer.size() - offset < chunk.value)
+                    {
+                        return errc::end_of_stream;
+                    }
+                    offset += static_cast<std::size_t>(chunk.value);
+                }
+                break;
+
+            case type_code::array:
+            case type_code::map:
+            {
+                bool const map = head.type == type_code::map;
+                if (head.indefinite())
+                {
+                    tagged = false;
+                    stack.push_back({0U, true, map});
+                    continue;
+                }
+                if (head.value == 0U)
+                {
+                    break;
+                }
+                // every subitem occupies at least one byte which allows us to
+                // check the whole container against the buffer at once
+                if ((remaining >> (map ? 1 : 0)) < head.value)
+                {
+                    return errc::end_of_stream;
+                }
+                tagged = false;
+                stack.push_back(
+                        {map ? head.value * 2U : head.value, false, map});
+                continue;
+            }
+
+            case type_code::tag:
+                tagged = true;
+                continue;
+
+            default:
+                return errc::invalid_additional_information;
+            }
+
+            // the item is complete which may complete its parents
+            tagged = false;
+            while (!stack.empty())
+            {
+                auto &top = stack.back();
+                if (top.indefinite)
+                {
+                    top.count += 1U;
+                    break;
+                }
+                if (--top.count != 0U)
+                {
+                    break;
+                }
+                stack.pop_back();
+            }
+            if (stack.empty())
+            {
+                return offset;
+            }
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+}
+
 } // namespace detail
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
@@ -65,6 +283,23 @@ auto skip_item(parse_context &ctx) noexcept -> result<void>
     constexpr int majorTypeBitOffset = 5;
     constexpr std::size_t numStackItems = 64;
 
+    if (!ctx.in.empty())
+    {
+        auto measureRx = detail::measure_item(
+                std::span<std::byte const>(ctx.in.data(), ctx.in.size()));
+        if (measureRx.has_value()) [[likely]]
+        {
+            ctx.in.discard_buffered(measureRx.assume_value());
+            return outcome::success();
+        }
+        if (measureRx.assume_error() != errc::end_of_stream
+            || ctx.in.input_size() <= ctx.in.size())
+        {
+            return static_cast<result<std::size_t> &&>(measureRx).as_failure();
+        }
+        // the item continues beyond the buffered input
+    }
+
     boost::container::small_vector<item_head, numStackItems> stack;
     if (auto &&parseHeadRx = dp::parse_item_head(ctx); parseHeadRx.has_error())
     {
@@ -7,12 +7,32 @@
 
 #pragma once
 
+#include <cstddef>
+#include <span>
+
 #include <dplx/dp/disappointment.hpp>
 #include <dplx/dp/fwd.hpp>
 
 namespace dplx::dp
 {
 
+namespace detail
+{
+
+/**
+ * Returns the encoded size of the first item in `buffer` or
+ * `errc::end_of_stream` if it is truncated. Only containers are tracked on
+ * the stack; scalars and tags don't touch it.
+ */
+auto measure_item(std::span<std::byte const> buffer) noexcept
+        -> result<std::size_t>;
+
+} // namespace detail
+
+/**
+ * Discards the next item. If it is completely buffered, the buffer is walked
+ * with raw pointers, see `detail::measure_item()`.
+ */
 auto skip_item(parse_context &ctx) noexcept -> result<void>;
 
 } // namespace dplx::dp
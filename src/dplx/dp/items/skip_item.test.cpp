@@ -7,6 +7,9 @@
 
 #include "dplx/dp/items/skip_item.hpp"
 
+#include <array>
+#include <span>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
@@ -96,4 +99,38 @@ TEST_CASE("skip_item can skip float double items")
     CHECK(ctx.stream.input_size() == 0U);
 }
 
+TEST_CASE("measure_item should walk buffered items")
+{
+    SECTION("nested containers followed by another item")
+    {
+        // [_ {1: 0(h'02')}, (_ "a", "b"), []], 0
+        std::array const encoded{
+                std::byte{0x9f}, std::byte{0xa1}, std::byte{0x01},
+                std::byte{0xc0}, std::byte{0x41}, std::byte{0x02},
+                std::byte{0x7f}, std::byte{0x61}, std::byte{0x61},
+                std::byte{0x61}, std::byte{0x62}, std::byte{0xff},
+                std::byte{0x80}, std::byte{0xff}, std::byte{0x00}};
+
+        auto const measureRx = dp::detail::measure_item(encoded);
+        REQUIRE(measureRx);
+        CHECK(measureRx.assume_value() == encoded.size() - 1U);
+    }
+    SECTION("a truncated container")
+    {
+        std::array const encoded{std::byte{0x83}, std::byte{0x01},
+                                 std::byte{0x02}};
+
+        CHECK(dp::detail::measure_item(encoded).error()
+              == dp::errc::end_of_stream);
+    }
+    SECTION("a tag followed by a break")
+    {
+        std::array const encoded{std::byte{0x9f}, std::byte{0xc0},
+                                 std::byte{0xff}};
+
+        CHECK(dp::detail::measure_item(encoded).error()
+              == dp::errc::item_type_mismatch);
+    }
+}
+
 } // namespace dp_tests
@@ -0,0 +1,307 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <boost/endian/conversion.hpp>
+
+#include <dplx/dp/cpos/container.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/items/emit_context.hpp>
+#include <dplx/dp/items/emit_core.hpp>
+#include <dplx/dp/items/encoded_item_head_size.hpp>
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/items/parse_ranges.hpp>
+#include <dplx/dp/items/type_code.hpp>
+
+// RFC 8746 typed arrays, i.e. a tag describing the element type followed by
+// a byte string containing the elements back to back. These are opt-in via
+// `as_typed_array`: the range codecs still emit one CBOR item per element.
+
+namespace dplx::dp
+{
+
+// clang-format off
+template <typename T>
+concept typed_array_element
+    = (std::integral<T> && !std::same_as<T, bool>
+            && (sizeof(T) == 1U || sizeof(T) == 2U || sizeof(T) == 4U
+                || sizeof(T) == 8U))
+    || std::same_as<T, float> || std::same_as<T, double>;
+// clang-format on
+
+namespace detail
+{
+
+inline constexpr std::uint64_t typed_array_tag_base = 64U;
+inline constexpr std::uint64_t typed_array_float_flag = 0b1'0000U;
+inline constexpr std::uint64_t typed_array_signed_flag = 0b0'1000U;
+inline constexpr std::uint64_t typed_array_little_endian_flag = 0b0'0100U;
+
+template <typename T>
+constexpr auto typed_array_tag(std::endian const byteOrder) noexcept
+        -> std::uint64_t
+{
+    std::uint64_t tag = typed_array_tag_base;
+    if constexpr (std::floating_point<T>)
+    {
+        // ll = 0 denotes binary16 which we don't support
+        tag |= typed_array_float_flag
+               | static_cast<unsigned>(std::countr_zero(sizeof(T)) - 1);
+    }
+    else
+    {
+        tag |= static_cast<unsigned>(std::countr_zero(sizeof(T)));
+        if constexpr (std::is_signed_v<T>)
+        {
+            tag |= typed_array_signed_flag;
+        }
+    }
+    // single byte elements have no byte order, the little endian
+    // variants denote clamped uint8 and a reserved value respectively
+    if (sizeof(T) > 1U && byteOrder == std::endian::little)
+    {
+        tag |= typed_array_little_endian_flag;
+    }
+    return tag;
+}
+
+template <typename T>
+inline void byteswap_elements(T *const elements,
+                              std::size_t const size) noexcept
+{
+    using uint_type = std::conditional_t<
+            sizeof(T) == sizeof(std::uint64_t), std::uint64_t,
+            std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+                               std::uint32_t, std::uint16_t>>;
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto &element = elements[i];
+        element = std::bit_cast<T>(boost::endian::endian_reverse(
+                std::bit_cast<uint_type>(element)));
+    }
+}
+
+// parses the tag and the byte string head of a typed array; returns the
+// number of elements and whether they need to be byte swapped
+template <typename T>
+inline auto parse_typed_array_head(parse_context &ctx, bool &swapBytes) noexcept
+        -> result<std::size_t>
+{
+    constexpr auto nativeTag = detail::typed_array_tag<T>(std::endian::native);
+    constexpr auto foreignTag = detail::typed_array_tag<T>(
+            std::endian::native == std::endian::little ? std::endian::big
+                                                       : std::endian::little);
+
+    DPLX_TRY(item_head const &tag, dp::parse_item_head(ctx));
+    if (tag.type != type_code::tag
+        || (tag.value != nativeTag && tag.value != foreignTag))
+    {
+        return errc::item_type_mismatch;
+    }
+    swapBytes = tag.value != nativeTag;
+
+    DPLX_TRY(item_head const &content, dp::parse_item_head(ctx));
+    if (content.type != type_code::binary)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (content.indefinite())
+    {
+        return errc::indefinite_item;
+    }
+    if (content.value % sizeof(T) != 0U)
+    {
+        return errc::item_value_out_of_range;
+    }
+    if (ctx.in.input_size() < content.value)
+    {
+        // defend against amplification attacks exhausting main memory
+        return errc::missing_data;
+    }
+    return static_cast<std::size_t>(content.value / sizeof(T));
+}
+
+} // namespace detail
+
+/**
+ * Emits the elements as an RFC 8746 typed array in native byte order, i.e.
+ * the content is written with a single bulk write.
+ */
+template <typed_array_element T>
+inline auto emit_typed_array(emit_context &ctx,
+                             std::span<T const> const elements) noexcept
+        -> result<void>
+{
+    DPLX_TRY(dp::emit_tag(ctx,
+                          detail::typed_array_tag<T>(std::endian::native)));
+    auto const bytes = std::as_bytes(elements);
+    return dp::emit_binary(ctx, bytes.data(), bytes.size());
+}
+
+template <typed_array_element T>
+[[nodiscard]] constexpr auto
+item_size_of_typed_array(emit_context &,
+                         std::span<T const> const elements) noexcept
+        -> std::uint64_t
+{
+    return dp::encoded_item_head_size<type_code::tag>(
+                   detail::typed_array_tag<T>(std::endian::native))
+         + dp::encoded_item_head_size<type_code::binary>(elements.size_bytes())
+         + elements.size_bytes();
+}
+
+// clang-format off
+template <typename Container>
+concept typed_array_container
+    = std::ranges::contiguous_range<Container>
+    && container_traits<Container>::resize
+    && typed_array_element<std::ranges::range_value_t<Container>>;
+// clang-format on
+
+/**
+ * Parses an RFC 8746 typed array of either byte order into the container
+ * with a single bulk read; elements of the foreign byte order are swapped
+ * afterwards.
+ */
+template <typed_array_container Container>
+inline auto parse_typed_array(parse_context &ctx, Container &dest) noexcept
+        -> result<std::size_t>
+{
+    using element_type = std::ranges::range_value_t<Container>;
+
+    bool swapBytes = false;
+    DPLX_TRY(std::size_t const size,
+             detail::parse_typed_array_head<element_type>(ctx, swapBytes));
+
+    DPLX_TRY(container_resize_for_overwrite(dest, size));
+    auto *const elements = std::ranges::data(dest);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    DPLX_TRY(ctx.in.bulk_read(reinterpret_cast<std::byte *>(elements),
+                              size * sizeof(element_type)));
+    if constexpr (sizeof(element_type) > 1U)
+    {
+        if (swapBytes)
+        {
+            detail::byteswap_elements(elements, size);
+        }
+    }
+    return size;
+}
+
+/**
+ * Returns a view of an RFC 8746 typed array which refers to the input
+ * buffer, see `parse_binary_borrowed()`. The elements can only be viewed in
+ * place if the input is resident, in native byte order and suitably aligned
+ * which the item heads preceding the content usually prevent. Otherwise
+ * they are copied (and swapped) into `ctx.borrow_arena`; without an arena
+ * this fails with `errc::input_not_borrowable` and `parse_typed_array()`
+ * should be used instead.
+ */
+template <typed_array_element T>
+inline auto parse_typed_array_borrowed(parse_context &ctx) noexcept
+        -> result<std::span<T const>>
+{
+    bool swapBytes = false;
+    DPLX_TRY(std::size_t const size,
+             detail::parse_typed_array_head<T>(ctx, swapBytes));
+
+    auto const byteSize = size * sizeof(T);
+    std::byte const *const content = ctx.in.data();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto const address = reinterpret_cast<std::uintptr_t>(content);
+    if (size == 0U
+        || (detail::input_is_resident(ctx.in) && !swapBytes
+            && address % alignof(T) == 0U))
+    {
+        ctx.in.discard_buffered(byteSize);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return std::span<T const>(reinterpret_cast<T const *>(content), size);
+    }
+
+    DPLX_TRY(std::byte *const copy,
+             detail::copy_borrowed(ctx, byteSize, alignof(T)));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto *const elements = reinterpret_cast<T *>(copy);
+    if constexpr (sizeof(T) > 1U)
+    {
+        if (swapBytes)
+        {
+            detail::byteswap_elements(elements, size);
+        }
+    }
+    return std::span<T const>(elements, size);
+}
+
+/**
+ * Opts a contiguous container into the RFC 8746 typed array encoding which
+ * the range codecs don't use, e.g. `dp::encode(out, dp::as_typed_array{v})`.
+ * Decoding requires a named wrapper, i.e. `dp::as_typed_array wrapper{v};`
+ * followed by `dp::decode(in, wrapper)`.
+ */
+template <typename Container>
+struct as_typed_array
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Container &elements;
+};
+
+template <typename Container>
+as_typed_array(Container &) -> as_typed_array<Container>;
+
+template <typename Container>
+class codec<as_typed_array<Container>>
+{
+    using element_type = std::ranges::range_value_t<Container>;
+
+public:
+    static auto size_of(emit_context &ctx,
+                        as_typed_array<Container> const &value) noexcept
+            -> std::uint64_t
+        requires std::ranges::contiguous_range<Container>
+                 && typed_array_element<element_type>
+    {
+        return dp::item_size_of_typed_array(ctx, elements_of(value));
+    }
+    static auto encode(emit_context &ctx,
+                       as_typed_array<Container> const &value) noexcept
+            -> result<void>
+        requires std::ranges::contiguous_range<Container>
+                 && typed_array_element<element_type>
+    {
+        return dp::emit_typed_array(ctx, elements_of(value));
+    }
+    static auto decode(parse_context &ctx,
+                       as_typed_array<Container> &value) noexcept
+            -> result<void>
+        requires typed_array_container<Container>
+    {
+        DPLX_TRY(dp::parse_typed_array(ctx, value.elements));
+        return outcome::success();
+    }
+
+private:
+    static auto elements_of(as_typed_array<Container> const &value) noexcept
+            -> std::span<element_type const>
+    {
+        return std::span<element_type const>(
+                std::ranges::data(value.elements),
+                std::ranges::size(value.elements));
+    }
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,172 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/items/typed_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <dplx/dp/cpos/container.std.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "dplx/dp/streams/memory_input_stream.hpp"
+#include "dplx/dp/streams/segmented_input_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(dp::detail::typed_array_tag<std::uint8_t>(std::endian::little)
+              == 64U);
+static_assert(dp::detail::typed_array_tag<std::uint16_t>(std::endian::big)
+              == 65U);
+static_assert(dp::detail::typed_array_tag<std::int8_t>(std::endian::little)
+              == 72U);
+static_assert(dp::detail::typed_array_tag<std::int64_t>(std::endian::little)
+              == 79U);
+static_assert(dp::detail::typed_array_tag<float>(std::endian::big) == 81U);
+static_assert(dp::detail::typed_array_tag<double>(std::endian::little)
+              == 86U);
+
+TEST_CASE("typed arrays should roundtrip")
+{
+    std::array const values{1.5F, -2.0F, 1024.25F};
+
+    dp::dynamic_memory_output_stream<> out;
+    dp::emit_context emitCtx{out};
+    REQUIRE(dp::emit_typed_array(emitCtx, std::span<float const>(values)));
+
+    auto const encoded = out.written();
+    CHECK(encoded.size()
+          == dp::item_size_of_typed_array(emitCtx,
+                                          std::span<float const>(values)));
+
+    SECTION("into a vector")
+    {
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in};
+
+        std::vector<float> decoded;
+        REQUIRE(dp::parse_typed_array(ctx, decoded));
+        CHECK(std::ranges::equal(decoded, values));
+        CHECK(in.empty());
+    }
+    SECTION("into a view")
+    {
+        // the item heads occupy three bytes, i.e. realign the content
+        std::vector<std::byte> aligned(encoded.size() + 1U);
+        std::ranges::copy(encoded, aligned.begin() + 1);
+        auto const content = std::span<std::byte const>(aligned).subspan(1U);
+        dp::memory_input_stream in(content);
+        dp::parse_context ctx{in};
+
+        auto parseRx = dp::parse_typed_array_borrowed<float>(ctx);
+        REQUIRE(parseRx);
+        CHECK(std::ranges::equal(parseRx.assume_value(), values));
+        CHECK(parseRx.assume_value().data()
+              == static_cast<void const *>(content.data() + 3));
+    }
+    SECTION("into a copy if the input isn't resident")
+    {
+        std::array const segments{encoded.first(5U), encoded.subspan(5U)};
+        dp::segmented_input_stream in(segments);
+        std::pmr::monotonic_buffer_resource arena;
+        dp::parse_context ctx{in};
+        ctx.borrow_arena = &arena;
+
+        auto parseRx = dp::parse_typed_array_borrowed<float>(ctx);
+        REQUIRE(parseRx);
+        CHECK(std::ranges::equal(parseRx.assume_value(), values));
+    }
+    SECTION("but not into a view of misaligned content without an arena")
+    {
+        std::vector<std::byte> misaligned(encoded.size() + 2U);
+        std::ranges::copy(encoded, misaligned.begin() + 2);
+        dp::memory_input_stream in(
+                std::span<std::byte const>(misaligned).subspan(2U));
+        dp::parse_context ctx{in};
+
+        CHECK(dp::parse_typed_array_borrowed<float>(ctx).error()
+              == dp::errc::input_not_borrowable);
+    }
+    SECTION("but not as a different element type")
+    {
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in};
+
+        std::vector<std::int32_t> decoded;
+        CHECK(dp::parse_typed_array(ctx, decoded).error()
+              == dp::errc::item_type_mismatch);
+    }
+}
+
+TEST_CASE("typed arrays of the foreign byte order should be swapped")
+{
+    constexpr auto foreignOrder = std::endian::native == std::endian::little
+                                          ? std::endian::big
+                                          : std::endian::little;
+    constexpr auto tag = dp::detail::typed_array_tag<std::uint16_t>(
+            foreignOrder);
+
+    std::array<std::byte, 7U> encoded{
+            std::byte{0xd8}, static_cast<std::byte>(tag),
+            std::byte{0x44}, std::byte{0x01},
+            std::byte{0x02}, std::byte{0x03},
+            std::byte{0x04}};
+    if constexpr (foreignOrder == std::endian::little)
+    {
+        std::swap(encoded[3], encoded[4]);
+        std::swap(encoded[5], encoded[6]);
+    }
+    dp::memory_input_stream in(encoded);
+    dp::parse_context ctx{in};
+
+    SECTION("into a vector")
+    {
+        std::vector<std::uint16_t> decoded;
+        REQUIRE(dp::parse_typed_array(ctx, decoded));
+        REQUIRE(decoded.size() == 2U);
+        CHECK(decoded[0] == 0x0102U);
+        CHECK(decoded[1] == 0x0304U);
+    }
+    SECTION("into a copy instead of a view")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        ctx.borrow_arena = &arena;
+
+        auto parseRx = dp::parse_typed_array_borrowed<std::uint16_t>(ctx);
+        REQUIRE(parseRx);
+        REQUIRE(parseRx.assume_value().size() == 2U);
+        CHECK(parseRx.assume_value()[0] == 0x0102U);
+        CHECK(parseRx.assume_value()[1] == 0x0304U);
+    }
+}
+
+TEST_CASE("as_typed_array should opt into the typed array encoding")
+{
+    std::vector<std::int32_t> const values{-1, 0, 0x1234'5678};
+
+    auto encodeRx = dp::encode_to_vector(
+            dp::as_typed_array{values});
+    REQUIRE(encodeRx);
+    auto const &encoded = encodeRx.assume_value();
+    CHECK(encoded.size() == 3U + values.size() * sizeof(std::int32_t));
+
+    std::vector<std::int32_t> decoded;
+    dp::as_typed_array wrapper{decoded};
+    REQUIRE(dp::decode(std::span<std::byte const>(encoded), wrapper));
+    CHECK(decoded == values);
+}
+
+} // namespace dp_tests
@@ -0,0 +1,219 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <dplx/dp/api.hpp>
+#include <dplx/dp/concepts.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/items/emit_context.hpp>
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/items/skip_item.hpp>
+#include <dplx/dp/streams/input_buffer.hpp>
+#include <dplx/dp/streams/output_buffer.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * The position of a top level item within a CBOR sequence.
+ */
+struct sequence_record
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+
+    friend auto operator==(sequence_record const &,
+                           sequence_record const &) noexcept -> bool
+            = default;
+};
+
+/**
+ * A record boundary within a CBOR sequence, i.e. the offset of the record
+ * with the given (zero based) index.
+ */
+struct sequence_checkpoint
+{
+    std::uint64_t record;
+    std::uint64_t offset;
+
+    friend auto operator==(sequence_checkpoint const &,
+                           sequence_checkpoint const &) noexcept -> bool
+            = default;
+};
+
+/**
+ * Writes a CBOR sequence (RFC 8742), i.e. back to back top level items.
+ *
+ * Records are emitted without syncing the output stream; `sync_output()` is
+ * only called after every `batchSize` records and by `flush()`. Therefore
+ * many small records share a single flush of the underlying stream.
+ */
+class sequence_writer
+{
+    emit_context mCtx;
+    std::size_t mBatchSize;
+    std::size_t mPendingRecords{0U};
+    std::uint64_t mRecordsWritten{0U};
+
+public:
+    static constexpr std::size_t default_batch_size = 1024U;
+
+    /**
+     * @param batchSize the number of records after which the output stream
+     * is synced; zero means only `flush()` syncs the output.
+     */
+    explicit sequence_writer(output_buffer &out,
+                             std::size_t const batchSize
+                             = default_batch_size) noexcept
+        : mCtx{out}
+        , mBatchSize(batchSize)
+    {
+    }
+
+    [[nodiscard]] auto context() noexcept -> emit_context &
+    {
+        return mCtx;
+    }
+    [[nodiscard]] auto records_written() const noexcept -> std::uint64_t
+    {
+        return mRecordsWritten;
+    }
+
+    template <typename T>
+        requires encodable<T>
+    auto write(T const &value) noexcept -> result<void>
+    {
+        DPLX_TRY(codec<T>::encode(mCtx, value));
+        return commit_record();
+    }
+    /**
+     * Writes a record which has been emitted manually via `context()`.
+     */
+    auto commit_record() noexcept -> result<void>
+    {
+        mRecordsWritten += 1U;
+        if (++mPendingRecords == mBatchSize) [[unlikely]]
+        {
+            return flush();
+        }
+        return outcome::success();
+    }
+
+    auto flush() noexcept -> result<void>
+    {
+        mPendingRecords = 0U;
+        return mCtx.out.sync_output();
+    }
+};
+
+/**
+ * Iterates the top level items of a CBOR sequence (RFC 8742).
+ *
+ * Each record can either be decoded or skipped. The reported offsets are
+ * relative to the input position at construction and are only meaningful if
+ * the input stream has a definite size.
+ */
+class sequence_reader
+{
+    parse_context mCtx;
+    std::uint64_t mStartInputSize;
+    std::uint64_t mRecordIndex{0U};
+
+public:
+    explicit sequence_reader(
+            input_buffer &in,
+            std::pmr::polymorphic_allocator<std::byte> const &allocator
+            = std::pmr::polymorphic_allocator<std::byte>{})
+        : mCtx(in, allocator)
+        , mStartInputSize(in.input_size())
+    {
+    }
+
+    [[nodiscard]] auto context() noexcept -> parse_context &
+    {
+        return mCtx;
+    }
+    /**
+     * The offset of the next record.
+     */
+    [[nodiscard]] auto offset() const noexcept -> std::uint64_t
+    {
+        return mStartInputSize - mCtx.in.input_size();
+    }
+    /**
+     * The index of the next record.
+     */
+    [[nodiscard]] auto record_index() const noexcept -> std::uint64_t
+    {
+        return mRecordIndex;
+    }
+
+    /**
+     * Returns false if the input has been consumed completely.
+     */
+    auto has_next() noexcept -> result<bool>
+    {
+        if (!mCtx.in.empty()) [[likely]]
+        {
+            return true;
+        }
+        if (auto requireRx = mCtx.in.require_input(1U);
+            requireRx.has_failure()) [[unlikely]]
+        {
+            if (requireRx.assume_error() == errc::end_of_stream)
+            {
+                return false;
+            }
+            return static_cast<decltype(requireRx) &&>(requireRx)
+                    .as_failure();
+        }
+        return true;
+    }
+
+    template <typename T>
+        requires decodable<T>
+    auto read(T &outValue) noexcept -> result<sequence_record>
+    {
+        auto const recordOffset = offset();
+        DPLX_TRY(codec<T>::decode(mCtx, outValue));
+        mRecordIndex += 1U;
+        return sequence_record{recordOffset, offset() - recordOffset};
+    }
+    auto skip() noexcept -> result<sequence_record>
+    {
+        auto const recordOffset = offset();
+        DPLX_TRY(dp::skip_item(mCtx));
+        mRecordIndex += 1U;
+        return sequence_record{recordOffset, offset() - recordOffset};
+    }
+
+    /**
+     * Discards the input up to the given record boundary without parsing
+     * the records in between. The checkpoint must not lie behind the
+     * current position, e.g. it has been obtained from a `sequence_index`.
+     */
+    auto advance_to(sequence_checkpoint const &checkpoint) noexcept
+            -> result<void>
+    {
+        auto const currentOffset = offset();
+        if (checkpoint.record < mRecordIndex
+            || checkpoint.offset < currentOffset) [[unlikely]]
+        {
+            return errc::item_value_out_of_range;
+        }
+        DPLX_TRY(mCtx.in.discard_input(checkpoint.offset - currentOffset));
+        mRecordIndex = checkpoint.record;
+        return outcome::success();
+    }
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,127 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/sequence.hpp"
+
+#include <array>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "dplx/dp/streams/memory_input_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("sequence_writer should emit back to back items")
+{
+    dp::dynamic_memory_output_stream<> out;
+    dp::sequence_writer subject(out);
+
+    REQUIRE(subject.write(1));
+    REQUIRE(subject.write(std::vector<int>{2, 3}));
+    REQUIRE(subject.write(0x1000));
+    REQUIRE(subject.flush());
+    CHECK(subject.records_written() == 3U);
+
+    auto const written = out.written();
+    std::array const expected{std::byte{0x01}, std::byte{0x82},
+                              std::byte{0x02}, std::byte{0x03},
+                              std::byte{0x19}, std::byte{0x10},
+                              std::byte{0x00}};
+    CHECK_BLOB_EQ(written, expected);
+}
+
+TEST_CASE("sequence_writer should sync once per batch")
+{
+    struct counting_stream final : dp::output_buffer
+    {
+        std::array<std::byte, 64U> content{};
+        int syncs{0};
+
+        counting_stream() noexcept
+        {
+            reset(content);
+        }
+
+    private:
+        auto do_grow(size_type) noexcept -> dp::result<void> override
+        {
+            return dp::errc::end_of_stream;
+        }
+        auto do_bulk_write(std::byte const *, std::size_t) noexcept
+                -> dp::result<void> override
+        {
+            return dp::errc::end_of_stream;
+        }
+        auto do_sync_output() noexcept -> dp::result<void> override
+        {
+            syncs += 1;
+            return dp::success();
+        }
+    };
+
+    counting_stream out;
+    dp::sequence_writer subject(out, 4U);
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(subject.write(i));
+    }
+    CHECK(out.syncs == 2);
+    REQUIRE(subject.flush());
+    CHECK(out.syncs == 3);
+}
+
+TEST_CASE("sequence_reader should iterate the records")
+{
+    std::array const encoded{std::byte{0x01}, std::byte{0x82},
+                             std::byte{0x02}, std::byte{0x03},
+                             std::byte{0x19}, std::byte{0x10},
+                             std::byte{0x00}};
+    dp::memory_input_stream inStream(encoded);
+    dp::sequence_reader subject(inStream);
+
+    REQUIRE(subject.has_next().value());
+    int first{};
+    auto const firstRecord = subject.read(first);
+    REQUIRE(firstRecord);
+    CHECK(first == 1);
+    CHECK(firstRecord.assume_value() == dp::sequence_record{0U, 1U});
+
+    REQUIRE(subject.has_next().value());
+    auto const secondRecord = subject.skip();
+    REQUIRE(secondRecord);
+    CHECK(secondRecord.assume_value() == dp::sequence_record{1U, 3U});
+
+    REQUIRE(subject.has_next().value());
+    int third{};
+    auto const thirdRecord = subject.read(third);
+    REQUIRE(thirdRecord);
+    CHECK(third == 0x1000);
+    CHECK(thirdRecord.assume_value() == dp::sequence_record{4U, 3U});
+
+    CHECK(!subject.has_next().value());
+    CHECK(subject.offset() == encoded.size());
+}
+
+TEST_CASE("sequence_reader should report truncated records")
+{
+    std::array const encoded{std::byte{0x01}, std::byte{0x19},
+                             std::byte{0x10}};
+    dp::memory_input_stream inStream(encoded);
+    dp::sequence_reader subject(inStream);
+
+    REQUIRE(subject.skip());
+    REQUIRE(subject.has_next().value());
+    CHECK(subject.skip().error() == dp::errc::end_of_stream);
+}
+
+} // namespace dp_tests
@@ -0,0 +1,223 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/sequence_index.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include <dplx/dp/items.hpp>
+
+namespace dplx::dp
+{
+
+auto sequence_index::build(input_buffer &in,
+                           std::uint64_t const stride) noexcept
+        -> result<sequence_index>
+{
+    if (stride == 0U)
+    {
+        return errc::item_value_out_of_range;
+    }
+
+    sequence_index index;
+    index.mStride = stride;
+
+    sequence_reader reader(in);
+    std::uint64_t untilCheckpoint = 0U;
+    for (;;)
+    {
+        DPLX_TRY(bool const hasNext, reader.has_next());
+        if (!hasNext)
+        {
+            break;
+        }
+        if (untilCheckpoint == 0U)
+        {
+            try
+            {
+                index.mCheckpoints.push_back(reader.offset());
+            }
+            catch (std::bad_alloc const &)
+            {
+                return errc::not_enough_memory;
+            }
+            untilCheckpoint = stride;
+        }
+        untilCheckpoint -= 1U;
+        DPLX_TRY(reader.skip());
+    }
+    index.mRecordCount = reader.record_index();
+    return index;
+}
+
+auto sequence_index::checkpoint_for_record(
+        std::uint64_t const record) const noexcept
+        -> result<sequence_checkpoint>
+{
+    if (record >= mRecordCount)
+    {
+        return errc::item_value_out_of_range;
+    }
+    auto const i = static_cast<std::size_t>(record / mStride);
+    return sequence_checkpoint{i * mStride, mCheckpoints[i]};
+}
+
+auto sequence_index::checkpoint_for_offset(
+        std::uint64_t const offset) const noexcept -> sequence_checkpoint
+{
+    auto const it = std::ranges::upper_bound(mCheckpoints, offset);
+    if (it == mCheckpoints.begin())
+    {
+        return sequence_checkpoint{0U, 0U};
+    }
+    auto const i = static_cast<std::uint64_t>(it - mCheckpoints.begin()) - 1U;
+    return sequence_checkpoint{i * mStride,
+                               mCheckpoints[static_cast<std::size_t>(i)]};
+}
+
+auto seek_record(sequence_reader &reader,
+                 sequence_index const &index,
+                 std::uint64_t const record) noexcept -> result<void>
+{
+    if (record < reader.record_index())
+    {
+        return errc::item_value_out_of_range;
+    }
+    DPLX_TRY(sequence_checkpoint const checkpoint,
+             index.checkpoint_for_record(record));
+    if (checkpoint.record > reader.record_index())
+    {
+        DPLX_TRY(reader.advance_to(checkpoint));
+    }
+    while (reader.record_index() < record)
+    {
+        DPLX_TRY(reader.skip());
+    }
+    return outcome::success();
+}
+
+auto seek_offset(sequence_reader &reader,
+                 sequence_index const &index,
+                 std::uint64_t const offset) noexcept -> result<void>
+{
+    if (auto const checkpoint = index.checkpoint_for_offset(offset);
+        checkpoint.record > reader.record_index())
+    {
+        DPLX_TRY(reader.advance_to(checkpoint));
+    }
+    while (reader.offset() < offset)
+    {
+        DPLX_TRY(bool const hasNext, reader.has_next());
+        if (!hasNext)
+        {
+            break;
+        }
+        DPLX_TRY(reader.skip());
+    }
+    return outcome::success();
+}
+
+// the index is encoded as [stride, recordCount, [checkpoint deltas...]]
+
+auto codec<sequence_index>::decode(parse_context &ctx,
+                                   sequence_index &value) noexcept
+        -> result<void>
+{
+    DPLX_TRY(dp::expect_item_head(ctx, type_code::array, 3U));
+
+    std::uint64_t stride{};
+    DPLX_TRY(dp::parse_integer(ctx, stride));
+    std::uint64_t recordCount{};
+    DPLX_TRY(dp::parse_integer(ctx, recordCount));
+    if (stride == 0U)
+    {
+        return errc::item_value_out_of_range;
+    }
+
+    DPLX_TRY(item_head const &head, dp::parse_item_head(ctx));
+    if (head.type != type_code::array)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (head.indefinite())
+    {
+        return errc::indefinite_item;
+    }
+    if (head.value != recordCount / stride + (recordCount % stride != 0U))
+    {
+        return errc::tuple_size_mismatch;
+    }
+    if (head.value > ctx.in.input_size())
+    {
+        // defend against amplification attacks exhausting main memory
+        return errc::missing_data;
+    }
+
+    std::vector<std::uint64_t> checkpoints;
+    try
+    {
+        checkpoints.resize(static_cast<std::size_t>(head.value));
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+    std::uint64_t offset = 0U;
+    for (auto &checkpoint : checkpoints)
+    {
+        std::uint64_t delta{};
+        DPLX_TRY(dp::parse_integer(ctx, delta));
+        if (delta > UINT64_MAX - offset)
+        {
+            return errc::item_value_out_of_range;
+        }
+        offset += delta;
+        checkpoint = offset;
+    }
+
+    value.mStride = stride;
+    value.mRecordCount = recordCount;
+    value.mCheckpoints
+            = static_cast<std::vector<std::uint64_t> &&>(checkpoints);
+    return outcome::success();
+}
+
+auto codec<sequence_index>::encode(emit_context &ctx,
+                                   sequence_index const &value) noexcept
+        -> result<void>
+{
+    DPLX_TRY(dp::emit_array(ctx, 3U));
+    DPLX_TRY(dp::emit_integer(ctx, value.mStride));
+    DPLX_TRY(dp::emit_integer(ctx, value.mRecordCount));
+    DPLX_TRY(dp::emit_array(ctx, value.mCheckpoints.size()));
+    std::uint64_t prev = 0U;
+    for (auto const checkpoint : value.mCheckpoints)
+    {
+        DPLX_TRY(dp::emit_integer(ctx, checkpoint - prev));
+        prev = checkpoint;
+    }
+    return outcome::success();
+}
+
+auto codec<sequence_index>::size_of(emit_context &ctx,
+                                    sequence_index const &value) noexcept
+        -> std::uint64_t
+{
+    std::uint64_t size = 1U + dp::item_size_of_integer(ctx, value.mStride)
+                       + dp::item_size_of_integer(ctx, value.mRecordCount)
+                       + dp::encoded_item_head_size<type_code::array>(
+                               value.mCheckpoints.size());
+    std::uint64_t prev = 0U;
+    for (auto const checkpoint : value.mCheckpoints)
+    {
+        size += dp::item_size_of_integer(ctx, checkpoint - prev);
+        prev = checkpoint;
+    }
+    return size;
+}
+
+} // namespace dplx::dp
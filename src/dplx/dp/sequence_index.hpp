@@ -0,0 +1,106 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/sequence.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * A sparse offset index over the records of a CBOR sequence.
+ *
+ * The offset of every `stride()`-th record is stored, i.e. any record can be
+ * reached by discarding the input up to the preceding checkpoint and
+ * skipping at most `stride() - 1` records. The index is encodable and meant
+ * to be stored as a sidecar file next to the sequence; the checkpoints are
+ * delta encoded which keeps it at a few bytes per checkpoint.
+ */
+class sequence_index
+{
+    std::uint64_t mStride{default_stride};
+    std::uint64_t mRecordCount{0U};
+    std::vector<std::uint64_t> mCheckpoints;
+
+public:
+    static constexpr std::uint64_t default_stride = 1024U;
+
+    sequence_index() noexcept = default;
+
+    /**
+     * Scans the sequence once and records every `stride`-th offset. The
+     * offsets are relative to the input position on entry.
+     */
+    static auto build(input_buffer &in,
+                      std::uint64_t stride = default_stride) noexcept
+            -> result<sequence_index>;
+
+    [[nodiscard]] auto stride() const noexcept -> std::uint64_t
+    {
+        return mStride;
+    }
+    [[nodiscard]] auto record_count() const noexcept -> std::uint64_t
+    {
+        return mRecordCount;
+    }
+    [[nodiscard]] auto checkpoints() const noexcept
+            -> std::span<std::uint64_t const>
+    {
+        return mCheckpoints;
+    }
+
+    /**
+     * Returns the closest checkpoint at or before the given record.
+     */
+    [[nodiscard]] auto
+    checkpoint_for_record(std::uint64_t record) const noexcept
+            -> result<sequence_checkpoint>;
+    /**
+     * Returns the closest checkpoint at or before the given offset.
+     */
+    [[nodiscard]] auto
+    checkpoint_for_offset(std::uint64_t offset) const noexcept
+            -> sequence_checkpoint;
+
+    friend class codec<sequence_index>;
+};
+
+/**
+ * Positions the reader in front of the given record. The reader must have
+ * been constructed at the position the index was built from and must not
+ * have passed the record yet.
+ */
+auto seek_record(sequence_reader &reader,
+                 sequence_index const &index,
+                 std::uint64_t record) noexcept -> result<void>;
+/**
+ * Positions the reader in front of the first record starting at or after
+ * `offset`, see `seek_record()`.
+ */
+auto seek_offset(sequence_reader &reader,
+                 sequence_index const &index,
+                 std::uint64_t offset) noexcept -> result<void>;
+
+template <>
+class codec<sequence_index>
+{
+public:
+    static auto decode(parse_context &ctx, sequence_index &value) noexcept
+            -> result<void>;
+    static auto encode(emit_context &ctx, sequence_index const &value) noexcept
+            -> result<void>;
+    static auto size_of(emit_context &ctx, sequence_index const &value) noexcept
+            -> std::uint64_t;
+};
+
+} // namespace dplx::dp
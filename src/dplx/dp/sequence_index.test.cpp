@@ -0,0 +1,131 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/sequence_index.hpp"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "dplx/dp/streams/memory_input_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+namespace
+{
+
+constexpr int num_records = 100;
+
+// records i < 24 take one byte, the others take two bytes
+auto make_sequence() -> dp::dynamic_memory_output_stream<>
+{
+    dp::dynamic_memory_output_stream<> out;
+    dp::sequence_writer writer(out);
+    for (int i = 0; i < num_records; ++i)
+    {
+        REQUIRE(writer.write(i));
+    }
+    REQUIRE(writer.flush());
+    return out;
+}
+
+auto offset_of(std::uint64_t const record) -> std::uint64_t
+{
+    return record < 24U ? record : 24U + (record - 24U) * 2U;
+}
+
+} // namespace
+
+TEST_CASE("sequence_index should record every stride-th offset")
+{
+    auto const sequence = make_sequence();
+    dp::memory_input_stream in(sequence.written());
+
+    auto buildRx = dp::sequence_index::build(in, 16U);
+    REQUIRE(buildRx);
+    auto const &subject = buildRx.assume_value();
+    CHECK(subject.stride() == 16U);
+    CHECK(subject.record_count() == num_records);
+    REQUIRE(subject.checkpoints().size() == 7U);
+    CHECK(subject.checkpoints()[0] == 0U);
+    CHECK(subject.checkpoints()[1] == 16U);
+    CHECK(subject.checkpoints()[2] == offset_of(32U));
+
+    CHECK(subject.checkpoint_for_record(40U).value()
+          == dp::sequence_checkpoint{32U, offset_of(32U)});
+    CHECK(subject.checkpoint_for_record(num_records).error()
+          == dp::errc::item_value_out_of_range);
+    CHECK(subject.checkpoint_for_offset(offset_of(48U) - 1U)
+          == dp::sequence_checkpoint{32U, offset_of(32U)});
+    CHECK(subject.checkpoint_for_offset(offset_of(48U))
+          == dp::sequence_checkpoint{48U, offset_of(48U)});
+}
+
+TEST_CASE("sequence_index should roundtrip as a sidecar")
+{
+    auto const sequence = make_sequence();
+    dp::memory_input_stream in(sequence.written());
+    auto buildRx = dp::sequence_index::build(in, 8U);
+    REQUIRE(buildRx);
+
+    auto encodeRx = dp::encode_to_vector(buildRx.assume_value());
+    REQUIRE(encodeRx);
+    dp::memory_input_stream sidecar(encodeRx.assume_value());
+    dp::sequence_index decoded;
+    REQUIRE(dp::decode(sidecar, decoded));
+
+    CHECK(decoded.stride() == 8U);
+    CHECK(decoded.record_count() == num_records);
+    CHECK(std::ranges::equal(decoded.checkpoints(),
+                             buildRx.assume_value().checkpoints()));
+}
+
+TEST_CASE("seek_record should position the reader in front of the record")
+{
+    auto const sequence = make_sequence();
+    dp::memory_input_stream indexIn(sequence.written());
+    auto buildRx = dp::sequence_index::build(indexIn, 16U);
+    REQUIRE(buildRx);
+    auto const &index = buildRx.assume_value();
+
+    auto const record = GENERATE(0, 1, 15, 16, 17, 40, 99);
+    INFO(record);
+    dp::memory_input_stream in(sequence.written());
+    dp::sequence_reader reader(in);
+    REQUIRE(dp::seek_record(reader, index, static_cast<std::uint64_t>(record)));
+    CHECK(reader.record_index() == static_cast<std::uint64_t>(record));
+    CHECK(reader.offset() == offset_of(static_cast<std::uint64_t>(record)));
+
+    int value{};
+    REQUIRE(reader.read(value));
+    CHECK(value == record);
+
+    CHECK(dp::seek_record(reader, index, 0U).error()
+          == dp::errc::item_value_out_of_range);
+}
+
+TEST_CASE("seek_offset should position the reader at the next record")
+{
+    auto const sequence = make_sequence();
+    dp::memory_input_stream indexIn(sequence.written());
+    auto buildRx = dp::sequence_index::build(indexIn, 16U);
+    REQUIRE(buildRx);
+
+    dp::memory_input_stream in(sequence.written());
+    dp::sequence_reader reader(in);
+    // offset 51 lies within record 37
+    REQUIRE(dp::seek_offset(reader, buildRx.assume_value(), 51U));
+    CHECK(reader.record_index() == 38U);
+    CHECK(reader.offset() == offset_of(38U));
+}
+
+} // namespace dp_tests
@@ -0,0 +1,50 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/allocators.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace dplx::dp::detail
+{
+
+namespace
+{
+
+constexpr std::size_t huge_page_size
+        = huge_page_allocator<std::byte>::huge_page_size;
+
+} // namespace
+
+auto allocate_huge_pages(std::size_t const size) -> void *
+{
+    if (size < huge_page_size)
+    {
+        return ::operator new(size);
+    }
+    void *const ptr = ::operator new(size, std::align_val_t{huge_page_size});
+#if defined(MADV_HUGEPAGE)
+    // only the fully covered huge pages can be backed by huge pages
+    (void)::madvise(ptr, size & ~(huge_page_size - 1U), MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void deallocate_huge_pages(void *const ptr, std::size_t const size) noexcept
+{
+    if (size < huge_page_size)
+    {
+        ::operator delete(ptr, size);
+    }
+    else
+    {
+        ::operator delete(ptr, size, std::align_val_t{huge_page_size});
+    }
+}
+
+} // namespace dplx::dp::detail
@@ -0,0 +1,118 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dplx::dp
+{
+
+/**
+ * An allocator adaptor which default initializes instead of value
+ * initializing elements constructed without arguments, i.e. it allows
+ * `std::vector<std::byte>::resize()` to skip zero filling.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class default_init_allocator : public Allocator
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+    template <typename U>
+    struct rebind
+    {
+        using other = default_init_allocator<
+                U,
+                typename alloc_traits::template rebind_alloc<U>>;
+    };
+
+    using Allocator::Allocator;
+    constexpr default_init_allocator() noexcept(
+            std::is_nothrow_default_constructible_v<Allocator>)
+            = default;
+
+    template <typename U, typename OtherAllocator>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr default_init_allocator(
+            default_init_allocator<U, OtherAllocator> const &other) noexcept
+        : Allocator(static_cast<OtherAllocator const &>(other))
+    {
+    }
+
+    template <typename U>
+    void construct(U *ptr) noexcept(
+            std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void *>(ptr)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U *ptr, Args &&...args)
+    {
+        alloc_traits::construct(static_cast<Allocator &>(*this), ptr,
+                                static_cast<Args &&>(args)...);
+    }
+};
+
+namespace detail
+{
+
+auto allocate_huge_pages(std::size_t size) -> void *;
+void deallocate_huge_pages(void *ptr, std::size_t size) noexcept;
+
+} // namespace detail
+
+/**
+ * An allocator which aligns large allocations to huge page boundaries and
+ * asks the OS to back them with huge pages (transparent huge pages on Linux,
+ * a no-op elsewhere).
+ */
+template <typename T>
+class huge_page_allocator
+{
+public:
+    using value_type = T;
+
+    /**
+     * Allocations of at least this many bytes are huge page aligned.
+     */
+    static constexpr std::size_t huge_page_size = 2U * 1024U * 1024U;
+
+    constexpr huge_page_allocator() noexcept = default;
+    template <typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr huge_page_allocator(huge_page_allocator<U> const &) noexcept
+    {
+    }
+
+    [[nodiscard]] auto allocate(std::size_t const n) -> T *
+    {
+        if (n > SIZE_MAX / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T *>(detail::allocate_huge_pages(n * sizeof(T)));
+    }
+    void deallocate(T *const ptr, std::size_t const n) noexcept
+    {
+        detail::deallocate_huge_pages(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    friend constexpr auto operator==(huge_page_allocator const &,
+                                     huge_page_allocator<U> const &) noexcept
+            -> bool
+    {
+        return true;
+    }
+};
+
+} // namespace dplx::dp
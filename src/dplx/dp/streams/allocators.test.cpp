@@ -0,0 +1,57 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/allocators.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("default_init_allocator should not value initialize")
+{
+    std::vector<std::byte, dp::default_init_allocator<std::byte>> subject;
+    subject.reserve(16U);
+    subject.push_back(std::byte{0x7f});
+    subject.resize(16U);
+    CHECK(subject.front() == std::byte{0x7f});
+
+    SECTION("but still construct with arguments")
+    {
+        subject.resize(32U, std::byte{0x11});
+        CHECK(subject.back() == std::byte{0x11});
+    }
+}
+
+TEST_CASE("default_init_allocator can be rebound")
+{
+    dp::default_init_allocator<std::byte> const subject;
+    dp::default_init_allocator<int> const rebound(subject);
+    CHECK(rebound == subject);
+}
+
+TEST_CASE("huge_page_allocator should align large allocations")
+{
+    constexpr auto hugePageSize
+            = dp::huge_page_allocator<std::byte>::huge_page_size;
+    dp::huge_page_allocator<std::byte> subject;
+
+    auto *const small = subject.allocate(64U);
+    CHECK(small != nullptr);
+    subject.deallocate(small, 64U);
+
+    auto *const large = subject.allocate(hugePageSize * 2U);
+    CHECK(reinterpret_cast<std::uintptr_t>(large) % hugePageSize == 0U);
+    large[hugePageSize * 2U - 1U] = std::byte{};
+    subject.deallocate(large, hugePageSize * 2U);
+}
+
+} // namespace dp_tests
@@ -0,0 +1,305 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/async_file_output_stream.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <dplx/dp/detail/posix_file.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * The state shared with the writer thread. The buffers are used round robin
+ * and identified by their submission sequence number.
+ */
+class async_file_output_stream::writer
+{
+    detail::posix_file mFile;
+    std::unique_ptr<std::byte[]> mStorage;
+    std::unique_ptr<std::size_t[]> mFillSizes;
+    std::size_t mBufferSize;
+    unsigned mBufferCount;
+    bool mSyncData;
+
+    std::mutex mMutex;
+    std::condition_variable mSubmitted;
+    std::condition_variable mCompleted;
+    std::uint64_t mNumSubmitted{0U};
+    std::uint64_t mNumCompleted{0U};
+    result<void> mWriteRx{outcome::success()};
+    bool mFailed{false};
+    bool mStopRequested{false};
+
+    std::thread mThread;
+
+public:
+    writer(detail::posix_file &&file,
+           std::size_t const bufferSize,
+           unsigned const bufferCount,
+           bool const syncData)
+        : mFile(std::move(file))
+        , mStorage(std::make_unique_for_overwrite<std::byte[]>(bufferSize
+                                                               * bufferCount))
+        , mFillSizes(std::make_unique<std::size_t[]>(bufferCount))
+        , mBufferSize(bufferSize)
+        , mBufferCount(bufferCount)
+        , mSyncData(syncData)
+    {
+    }
+    ~writer() noexcept
+    {
+        if (mThread.joinable())
+        {
+            {
+                std::lock_guard lock(mMutex);
+                mStopRequested = true;
+            }
+            mSubmitted.notify_one();
+            mThread.join();
+        }
+    }
+
+    writer(writer const &) = delete;
+    auto operator=(writer const &) -> writer & = delete;
+
+    void start()
+    {
+        mThread = std::thread(&writer::run, this);
+    }
+
+    [[nodiscard]] auto buffer_size() const noexcept -> std::size_t
+    {
+        return mBufferSize;
+    }
+    [[nodiscard]] auto buffer(std::uint64_t const sequenceNumber) const noexcept
+            -> std::byte *
+    {
+        auto const index = static_cast<std::size_t>(sequenceNumber % mBufferCount);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return mStorage.get() + index * mBufferSize;
+    }
+
+    /**
+     * Hands the current buffer off to the writer thread and waits until the
+     * next buffer is available.
+     */
+    auto submit(std::size_t const fillSize) noexcept -> result<std::byte *>
+    {
+        std::unique_lock lock(mMutex);
+        if (fillSize > 0U)
+        {
+            mFillSizes[mNumSubmitted % mBufferCount] = fillSize;
+            mNumSubmitted += 1U;
+            mSubmitted.notify_one();
+        }
+        mCompleted.wait(lock, [this] {
+            return mNumSubmitted - mNumCompleted < mBufferCount || mFailed;
+        });
+        if (mFailed)
+        {
+            return take_failure().as_failure();
+        }
+        return buffer(mNumSubmitted);
+    }
+
+    /**
+     * Waits until all submitted buffers have been written.
+     */
+    auto wait_idle() noexcept -> result<void>
+    {
+        {
+            std::unique_lock lock(mMutex);
+            mCompleted.wait(lock, [this] {
+                return mNumSubmitted == mNumCompleted;
+            });
+            if (mFailed)
+            {
+                return take_failure();
+            }
+        }
+        if (mSyncData)
+        {
+            DPLX_TRY(mFile.sync_data());
+        }
+        return outcome::success();
+    }
+
+private:
+    auto take_failure() noexcept -> result<void>
+    {
+        // the first failure is reported verbatim
+        return std::exchange(mWriteRx, system_error::errc::io_error);
+    }
+
+    void run() noexcept
+    {
+        std::unique_lock lock(mMutex);
+        for (;;)
+        {
+            mSubmitted.wait(lock, [this] {
+                return mNumCompleted != mNumSubmitted || mStopRequested;
+            });
+            if (mNumCompleted == mNumSubmitted)
+            {
+                return;
+            }
+
+            auto const sequenceNumber = mNumCompleted;
+            auto const fillSize = mFillSizes[sequenceNumber % mBufferCount];
+            auto const skip = mFailed;
+            lock.unlock();
+
+            // once a write failed, all subsequent buffers are dropped in
+            // order to not create holes in the file
+            result<void> writeRx = outcome::success();
+            if (!skip)
+            {
+                writeRx = mFile.write(buffer(sequenceNumber), fillSize);
+            }
+
+            lock.lock();
+            if (writeRx.has_failure())
+            {
+                mWriteRx = std::move(writeRx);
+                mFailed = true;
+            }
+            mNumCompleted += 1U;
+            mCompleted.notify_one();
+        }
+    }
+};
+
+async_file_output_stream::~async_file_output_stream() noexcept = default;
+async_file_output_stream::async_file_output_stream() noexcept = default;
+
+async_file_output_stream::async_file_output_stream(
+        async_file_output_stream &&other) noexcept
+    : output_buffer(static_cast<output_buffer &&>(other))
+    , mWriter(std::move(other.mWriter))
+    , mCurrentBuffer(std::exchange(other.mCurrentBuffer, nullptr))
+    , mBufferSize(std::exchange(other.mBufferSize, 0U))
+    , mSubmittedSize(std::exchange(other.mSubmittedSize, 0U))
+{
+    other.reset();
+}
+
+auto async_file_output_stream::operator=(
+        async_file_output_stream &&other) noexcept -> async_file_output_stream &
+{
+    if (this != &other)
+    {
+        output_buffer::operator=(static_cast<output_buffer &&>(other));
+        mWriter = std::move(other.mWriter);
+        mCurrentBuffer = std::exchange(other.mCurrentBuffer, nullptr);
+        mBufferSize = std::exchange(other.mBufferSize, 0U);
+        mSubmittedSize = std::exchange(other.mSubmittedSize, 0U);
+        other.reset();
+    }
+    return *this;
+}
+
+async_file_output_stream::async_file_output_stream(
+        std::unique_ptr<writer> &&w) noexcept
+    : output_buffer(w->buffer(0U), w->buffer_size())
+    , mWriter(std::move(w))
+    , mCurrentBuffer(data())
+    , mBufferSize(mWriter->buffer_size())
+{
+}
+
+auto async_file_output_stream::create(
+        std::filesystem::path const &path,
+        async_file_output_options const &options) noexcept
+        -> result<async_file_output_stream>
+{
+    auto const bufferSize = std::max<std::size_t>(options.buffer_size,
+                                                  minimum_output_buffer_size);
+    auto const bufferCount = std::max(options.buffer_count, 2U);
+
+    DPLX_TRY(auto &&file, detail::posix_file::open(
+                                  path, detail::file_open_mode::write_truncate));
+    try
+    {
+        auto w = std::make_unique<writer>(std::move(file), bufferSize,
+                                          bufferCount, options.sync_data);
+        w->start();
+        return async_file_output_stream(std::move(w));
+    }
+    catch (std::bad_alloc const &)
+    {
+        return system_error::errc::not_enough_memory;
+    }
+    catch (std::system_error const &)
+    {
+        // std::thread failed to launch
+        return system_error::errc::resource_unavailable_try_again;
+    }
+}
+
+auto async_file_output_stream::rotate() noexcept -> result<void>
+{
+    auto const fillSize = mBufferSize - size();
+    DPLX_TRY(auto *nextBuffer, mWriter->submit(fillSize));
+    mSubmittedSize += fillSize;
+    mCurrentBuffer = nextBuffer;
+    output_buffer::reset(mCurrentBuffer, mBufferSize);
+    return outcome::success();
+}
+
+auto async_file_output_stream::do_grow(size_type const requestedSize) noexcept
+        -> result<void>
+{
+    if (requestedSize > mBufferSize)
+    {
+        return errc::buffer_size_exceeded;
+    }
+    return rotate();
+}
+
+auto async_file_output_stream::do_bulk_write(std::byte const *src,
+                                             std::size_t srcSize) noexcept
+        -> result<void>
+{
+    if (!mWriter) [[unlikely]]
+    {
+        return errc::buffer_size_exceeded;
+    }
+    // output_buffer::bulk_write() has already filled the current buffer
+    do
+    {
+        DPLX_TRY(rotate());
+
+        auto const chunkSize = std::min(srcSize, size());
+        std::memcpy(data(), src, chunkSize);
+        commit_written(chunkSize);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        src += chunkSize;
+        srcSize -= chunkSize;
+    }
+    while (srcSize > 0U);
+    return outcome::success();
+}
+
+auto async_file_output_stream::do_sync_output() noexcept -> result<void>
+{
+    if (!mWriter) [[unlikely]]
+    {
+        return outcome::success();
+    }
+    DPLX_TRY(rotate());
+    return mWriter->wait_idle();
+}
+
+} // namespace dplx::dp
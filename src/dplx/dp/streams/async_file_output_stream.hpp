@@ -0,0 +1,105 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/output_buffer.hpp>
+
+namespace dplx::dp
+{
+
+struct async_file_output_options
+{
+    /**
+     * The size of each rotating buffer.
+     */
+    std::size_t buffer_size = 256U * 1024U;
+    /**
+     * The number of rotating buffers; at least two are used. The encoder only
+     * blocks if all of them are waiting to be written.
+     */
+    unsigned buffer_count = 2U;
+    /**
+     * Whether `sync_output()` additionally flushes the file content to the
+     * storage device (`fdatasync()`).
+     */
+    bool sync_data = false;
+};
+
+/**
+ * An output stream which rotates between a fixed number of buffers. Filled
+ * buffers are handed off to a background writer thread, i.e. the encoder
+ * continues with the next buffer while the previous one is being written.
+ * `sync_output()` submits the current buffer and waits for all outstanding
+ * writes.
+ *
+ * Write failures are reported by the next operation which hands off a
+ * buffer or by `sync_output()`.
+ *
+ * @note Content which hasn't been submitted is _not_ written by the
+ *       destructor, i.e. the stream must be synced with `sync_output()` in
+ *       order to persist it. Already submitted buffers are written before the
+ *       destructor returns.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class async_file_output_stream final : public output_buffer
+{
+    class writer;
+
+    std::unique_ptr<writer> mWriter;
+    std::byte *mCurrentBuffer{nullptr};
+    std::size_t mBufferSize{0U};
+    std::uint64_t mSubmittedSize{0U};
+
+public:
+    ~async_file_output_stream() noexcept;
+    async_file_output_stream() noexcept;
+
+    async_file_output_stream(async_file_output_stream const &) = delete;
+    auto operator=(async_file_output_stream const &)
+            -> async_file_output_stream & = delete;
+
+    async_file_output_stream(async_file_output_stream &&other) noexcept;
+    auto operator=(async_file_output_stream &&other) noexcept
+            -> async_file_output_stream &;
+
+    /**
+     * Creates (or truncates) the file, allocates the buffers and starts the
+     * writer thread.
+     */
+    static auto create(std::filesystem::path const &path,
+                       async_file_output_options const &options = {}) noexcept
+            -> result<async_file_output_stream>;
+
+    /**
+     * The number of bytes written into the stream so far (including the
+     * bytes in the current buffer).
+     */
+    [[nodiscard]] auto written_size() const noexcept -> std::uint64_t
+    {
+        return mSubmittedSize + (mBufferSize - size());
+    }
+
+private:
+    explicit async_file_output_stream(std::unique_ptr<writer> &&w) noexcept;
+
+    auto rotate() noexcept -> result<void>;
+
+    auto do_grow(size_type requestedSize) noexcept -> result<void> override;
+    auto do_bulk_write(std::byte const *src, std::size_t srcSize) noexcept
+            -> result<void> override;
+    auto do_sync_output() noexcept -> result<void> override;
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,132 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/async_file_output_stream.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "temporary_file.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(
+        std::derived_from<dp::async_file_output_stream, dp::output_buffer>);
+static_assert(dp::output_stream<dp::async_file_output_stream &>);
+static_assert(std::movable<dp::async_file_output_stream>);
+static_assert(!std::copyable<dp::async_file_output_stream>);
+
+namespace
+{
+
+auto make_payload(std::size_t const size) -> std::vector<std::byte>
+{
+    std::vector<std::byte> payload(size);
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        payload[i] = static_cast<std::byte>(i % 251U);
+    }
+    return payload;
+}
+
+} // namespace
+
+TEST_CASE("async_file_output_stream should be default constructible")
+{
+    dp::async_file_output_stream subject;
+    CHECK(subject.empty());
+    CHECK(subject.written_size() == 0U);
+    CHECK(subject.ensure_size(1U).error() == dp::errc::buffer_size_exceeded);
+    CHECK(subject.sync_output());
+}
+
+TEST_CASE("async_file_output_stream should create a file")
+{
+    constexpr std::size_t bufferSize = 64U;
+    auto const bufferCount = GENERATE(2U, 3U);
+    INFO("buffer count: " << bufferCount);
+
+    temporary_file const file;
+    auto createRx = dp::async_file_output_stream::create(
+            file.path(), {.buffer_size = bufferSize,
+                          .buffer_count = bufferCount,
+                          .sync_data = true});
+    REQUIRE(createRx);
+    auto subject = std::move(createRx).assume_value();
+
+    REQUIRE(subject.size() == bufferSize);
+    CHECK(std::filesystem::exists(file.path()));
+
+    SECTION("and rotate buffers if more space is requested")
+    {
+        auto const *const first = subject.data();
+        subject.commit_written(bufferSize - 1U);
+        REQUIRE(subject.ensure_size(2U));
+        CHECK(subject.size() == bufferSize);
+        CHECK(subject.data() != first);
+        CHECK(subject.written_size() == bufferSize - 1U);
+
+        REQUIRE(subject.sync_output());
+        CHECK(file.content().size() == bufferSize - 1U);
+    }
+    SECTION("and reject requests exceeding the buffer size")
+    {
+        CHECK(subject.ensure_size(bufferSize + 1U).error()
+              == dp::errc::buffer_size_exceeded);
+    }
+    SECTION("and write large payloads in order")
+    {
+        auto const payload = make_payload(bufferSize * 7U + 3U);
+        REQUIRE(subject.bulk_write(payload.data(), payload.size()));
+        CHECK(subject.written_size() == payload.size());
+
+        REQUIRE(subject.sync_output());
+        CHECK_BLOB_EQ(file.content(), payload);
+    }
+    SECTION("and be movable")
+    {
+        auto const payload = make_payload(bufferSize * 3U);
+        REQUIRE(subject.bulk_write(payload.data(), payload.size()));
+
+        dp::async_file_output_stream moved(std::move(subject));
+        CHECK(moved.written_size() == payload.size());
+        REQUIRE(moved.sync_output());
+        CHECK_BLOB_EQ(file.content(), payload);
+    }
+}
+
+TEST_CASE("async_file_output_stream can be encoded into")
+{
+    std::vector<int> values(4096U);
+    std::iota(values.begin(), values.end(), 0x10000);
+
+    dp::dynamic_memory_output_stream<> expected;
+    REQUIRE(dp::encode(expected, values));
+
+    temporary_file const file;
+    {
+        auto createRx = dp::async_file_output_stream::create(
+                file.path(), {.buffer_size = 128U, .buffer_count = 4U});
+        REQUIRE(createRx);
+        auto subject = std::move(createRx).assume_value();
+
+        REQUIRE(dp::encode(subject, values));
+        CHECK(subject.written_size() == expected.written_size());
+    }
+    CHECK_BLOB_EQ(file.content(), expected.written());
+}
+
+} // namespace dp_tests
@@ -0,0 +1,173 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/buffer_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <utility>
+
+namespace dplx::dp
+{
+
+buffer_pool::~buffer_pool() noexcept = default;
+
+buffer_pool::buffer_pool(std::size_t const maxBuffersPerClass)
+    : mMutex()
+    , mFreelists()
+    , mMaxBuffersPerClass(maxBuffersPerClass)
+{
+    // returning buffers must not allocate
+    for (auto &freelist : mFreelists)
+    {
+        freelist.reserve(maxBuffersPerClass);
+    }
+}
+
+auto buffer_pool::lease(std::size_t const minSize) noexcept
+        -> result<buffer_type>
+{
+    if (minSize > max_buffer_size)
+    {
+        return allocate(minSize);
+    }
+    auto const sizeClass = size_class_for(minSize);
+    buffer_type buffer;
+    if (take(sizeClass, std::span(&buffer, 1U)) == 0U)
+    {
+        return allocate(class_size(sizeClass));
+    }
+    return buffer;
+}
+
+void buffer_pool::recycle(buffer_type &&buffer) noexcept
+{
+    if (buffer.capacity() < min_buffer_size)
+    {
+        return;
+    }
+    // this neither allocates nor initializes any bytes
+    buffer.resize(buffer.capacity());
+    give(size_class_of(buffer.capacity()), std::span(&buffer, 1U));
+}
+
+auto buffer_pool::take(std::size_t const sizeClass,
+                       std::span<buffer_type> const buffers) noexcept
+        -> std::size_t
+{
+    std::lock_guard lock(mMutex);
+    auto &freelist = mFreelists[sizeClass];
+    auto const num = std::min(buffers.size(), freelist.size());
+    for (std::size_t i = 0U; i < num; ++i)
+    {
+        buffers[i] = std::move(freelist.back());
+        freelist.pop_back();
+    }
+    return num;
+}
+
+void buffer_pool::give(std::size_t const sizeClass,
+                       std::span<buffer_type> const buffers) noexcept
+{
+    std::lock_guard lock(mMutex);
+    auto &freelist = mFreelists[sizeClass];
+    for (auto &buffer : buffers)
+    {
+        if (freelist.size() == mMaxBuffersPerClass)
+        {
+            break;
+        }
+        freelist.push_back(std::move(buffer));
+    }
+}
+
+auto buffer_pool::size_class_for(std::size_t const minSize) noexcept
+        -> std::size_t
+{
+    if (minSize <= min_buffer_size)
+    {
+        return 0U;
+    }
+    auto const sizeClass = static_cast<std::size_t>(
+            std::bit_width((minSize - 1U) / min_buffer_size));
+    return std::min(sizeClass, num_size_classes - 1U);
+}
+
+auto buffer_pool::size_class_of(std::size_t const capacity) noexcept
+        -> std::size_t
+{
+    auto const sizeClass = static_cast<std::size_t>(
+            std::bit_width(capacity / min_buffer_size) - 1);
+    return std::min(sizeClass, num_size_classes - 1U);
+}
+
+auto buffer_pool::allocate(std::size_t const size) noexcept
+        -> result<buffer_type>
+try
+{
+    return buffer_type(size);
+}
+catch (std::bad_alloc const &)
+{
+    return system_error::errc::not_enough_memory;
+}
+
+buffer_cache::~buffer_cache() noexcept
+{
+    for (std::size_t i = 0U; i < mBuckets.size(); ++i)
+    {
+        auto &bucket = mBuckets[i];
+        mPool->give(i, std::span(bucket.buffers).first(bucket.size));
+    }
+}
+
+auto buffer_cache::lease(std::size_t const minSize) noexcept
+        -> result<buffer_type>
+{
+    if (minSize > buffer_pool::max_buffer_size)
+    {
+        return buffer_pool::allocate(minSize);
+    }
+    auto const sizeClass = buffer_pool::size_class_for(minSize);
+    auto &bucket = mBuckets[sizeClass];
+    if (bucket.size == 0U)
+    {
+        bucket.size = mPool->take(
+                sizeClass, std::span(bucket.buffers).first(batch_size));
+        if (bucket.size == 0U)
+        {
+            return buffer_pool::allocate(buffer_pool::class_size(sizeClass));
+        }
+    }
+    bucket.size -= 1U;
+    return std::move(bucket.buffers[bucket.size]);
+}
+
+void buffer_cache::recycle(buffer_type &&buffer) noexcept
+{
+    if (buffer.capacity() < buffer_pool::min_buffer_size)
+    {
+        return;
+    }
+    // this neither allocates nor initializes any bytes
+    buffer.resize(buffer.capacity());
+
+    auto const sizeClass = buffer_pool::size_class_of(buffer.capacity());
+    auto &bucket = mBuckets[sizeClass];
+    if (bucket.size == cache_size)
+    {
+        // spill the older half of the cache
+        mPool->give(sizeClass, std::span(bucket.buffers).first(batch_size));
+        std::move(bucket.buffers.begin() + batch_size, bucket.buffers.end(),
+                  bucket.buffers.begin());
+        bucket.size -= batch_size;
+    }
+    bucket.buffers[bucket.size] = std::move(buffer);
+    bucket.size += 1U;
+}
+
+} // namespace dplx::dp
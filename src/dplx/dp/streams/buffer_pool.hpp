@@ -0,0 +1,216 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/allocators.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * Predicts the encoded size of a message type from the sizes of recently
+ * encoded messages, e.g. in order to lease an appropriately sized buffer.
+ *
+ * The estimate immediately follows larger messages and decays by 1/8 for
+ * each smaller one. Concurrent use is safe, but racing updates may be lost.
+ */
+class message_size_hint
+{
+    std::atomic<std::size_t> mEstimate;
+
+public:
+    explicit constexpr message_size_hint(
+            std::size_t const initialEstimate = 0U) noexcept
+        : mEstimate(initialEstimate)
+    {
+    }
+
+    [[nodiscard]] auto predict() const noexcept -> std::size_t
+    {
+        return mEstimate.load(std::memory_order::relaxed);
+    }
+
+    void observe(std::size_t const encodedSize) noexcept
+    {
+        auto const estimate = mEstimate.load(std::memory_order::relaxed);
+        auto const decayed = estimate - estimate / 8U;
+        mEstimate.store(encodedSize > decayed ? encodedSize : decayed,
+                        std::memory_order::relaxed);
+    }
+};
+
+/**
+ * A thread safe freelist of output buffers bucketed into power of two size
+ * classes. Buffers are meant to be handed to `dynamic_memory_output_stream`
+ * and recycled after the encoded message has been consumed.
+ *
+ * Threads should access the pool through a `buffer_cache` which amortizes
+ * the synchronization cost.
+ */
+class buffer_pool
+{
+public:
+    /// the allocator skips zero filling, i.e. neither allocating nor
+    /// recycling a buffer touches its bytes
+    using buffer_type
+            = std::vector<std::byte, default_init_allocator<std::byte>>;
+
+    static constexpr std::size_t min_buffer_size = 4U * 1024U;
+    static constexpr std::size_t max_buffer_size = 16U * 1024U * 1024U;
+    static constexpr std::size_t num_size_classes = 13U;
+    static_assert(min_buffer_size << (num_size_classes - 1U)
+                  == max_buffer_size);
+
+private:
+    std::mutex mMutex;
+    std::array<std::vector<buffer_type>, num_size_classes> mFreelists;
+    std::size_t mMaxBuffersPerClass;
+
+public:
+    ~buffer_pool() noexcept;
+
+    buffer_pool(buffer_pool const &) = delete;
+    auto operator=(buffer_pool const &) -> buffer_pool & = delete;
+    buffer_pool(buffer_pool &&) = delete;
+    auto operator=(buffer_pool &&) -> buffer_pool & = delete;
+
+    /**
+     * @param maxBuffersPerClass the freelist capacity of each size class
+     *        which is allocated upfront; excess buffers are freed on return
+     */
+    explicit buffer_pool(std::size_t maxBuffersPerClass = 64U);
+
+    /**
+     * Returns a buffer whose `size()` is at least `minSize`. Requests
+     * exceeding `max_buffer_size` are served with a fresh allocation.
+     */
+    auto lease(std::size_t minSize) noexcept -> result<buffer_type>;
+    /**
+     * Returns a buffer sized for the predicted message size.
+     */
+    auto lease(message_size_hint const &hint) noexcept -> result<buffer_type>
+    {
+        return lease(hint.predict());
+    }
+    /**
+     * Returns a buffer to the pool. The buffer is resized to its capacity
+     * without initializing any bytes.
+     */
+    void recycle(buffer_type &&buffer) noexcept;
+    /**
+     * Feeds the size of the buffer, i.e. the written size of the message
+     * encoded into it, to the hint and returns the buffer to the pool.
+     */
+    void recycle(buffer_type &&buffer, message_size_hint &hint) noexcept
+    {
+        hint.observe(buffer.size());
+        recycle(static_cast<buffer_type &&>(buffer));
+    }
+
+    /**
+     * Moves up to `buffers.size()` buffers of the given size class into
+     * `buffers` and returns the number of transferred buffers.
+     */
+    auto take(std::size_t sizeClass, std::span<buffer_type> buffers) noexcept
+            -> std::size_t;
+    /**
+     * Moves the buffers into the freelist of the given size class. Buffers
+     * which don't fit are freed.
+     */
+    void give(std::size_t sizeClass, std::span<buffer_type> buffers) noexcept;
+
+    /**
+     * The index of the smallest size class which can satisfy `minSize`.
+     */
+    [[nodiscard]] static auto size_class_for(std::size_t minSize) noexcept
+            -> std::size_t;
+    /**
+     * The index of the largest size class whose size a buffer with
+     * `capacity` bytes satisfies.
+     */
+    [[nodiscard]] static auto size_class_of(std::size_t capacity) noexcept
+            -> std::size_t;
+    [[nodiscard]] static constexpr auto
+    class_size(std::size_t const sizeClass) noexcept -> std::size_t
+    {
+        return min_buffer_size << sizeClass;
+    }
+
+    static auto allocate(std::size_t size) noexcept -> result<buffer_type>;
+};
+
+/**
+ * A single threaded front-end of a `buffer_pool`. It caches a few buffers per
+ * size class and exchanges them with the shared pool in batches. Cached
+ * buffers are given back to the pool on destruction.
+ */
+class buffer_cache
+{
+public:
+    using buffer_type = buffer_pool::buffer_type;
+
+    static constexpr std::size_t batch_size = 4U;
+    static constexpr std::size_t cache_size = 2U * batch_size;
+
+private:
+    struct bucket
+    {
+        std::array<buffer_type, cache_size> buffers;
+        std::size_t size;
+    };
+
+    buffer_pool *mPool;
+    std::array<bucket, buffer_pool::num_size_classes> mBuckets{};
+
+public:
+    ~buffer_cache() noexcept;
+
+    buffer_cache(buffer_cache const &) = delete;
+    auto operator=(buffer_cache const &) -> buffer_cache & = delete;
+    buffer_cache(buffer_cache &&) = delete;
+    auto operator=(buffer_cache &&) -> buffer_cache & = delete;
+
+    explicit buffer_cache(buffer_pool &pool) noexcept
+        : mPool(&pool)
+    {
+    }
+
+    /**
+     * Returns a buffer whose `size()` is at least `minSize`.
+     */
+    auto lease(std::size_t minSize) noexcept -> result<buffer_type>;
+    /**
+     * Returns a buffer sized for the predicted message size.
+     */
+    auto lease(message_size_hint const &hint) noexcept -> result<buffer_type>
+    {
+        return lease(hint.predict());
+    }
+    /**
+     * Returns a buffer to the cache. See `buffer_pool::recycle()`.
+     */
+    void recycle(buffer_type &&buffer) noexcept;
+    /**
+     * See `buffer_pool::recycle(buffer_type &&, message_size_hint &)`.
+     */
+    void recycle(buffer_type &&buffer, message_size_hint &hint) noexcept
+    {
+        hint.observe(buffer.size());
+        recycle(static_cast<buffer_type &&>(buffer));
+    }
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,194 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/buffer_pool.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("buffer_pool size classes are powers of two")
+{
+    CHECK(dp::buffer_pool::size_class_for(0U) == 0U);
+    CHECK(dp::buffer_pool::size_class_for(4096U) == 0U);
+    CHECK(dp::buffer_pool::size_class_for(4097U) == 1U);
+    CHECK(dp::buffer_pool::size_class_for(8192U) == 1U);
+    CHECK(dp::buffer_pool::size_class_for(8193U) == 2U);
+    CHECK(dp::buffer_pool::size_class_for(dp::buffer_pool::max_buffer_size)
+          == dp::buffer_pool::num_size_classes - 1U);
+
+    CHECK(dp::buffer_pool::size_class_of(4096U) == 0U);
+    CHECK(dp::buffer_pool::size_class_of(6144U) == 0U);
+    CHECK(dp::buffer_pool::size_class_of(8192U) == 1U);
+    CHECK(dp::buffer_pool::size_class_of(dp::buffer_pool::max_buffer_size * 4U)
+          == dp::buffer_pool::num_size_classes - 1U);
+}
+
+TEST_CASE("buffer_pool should recycle buffers")
+{
+    dp::buffer_pool subject(2U);
+
+    auto leaseRx = subject.lease(5000U);
+    REQUIRE(leaseRx);
+    auto buffer = std::move(leaseRx).assume_value();
+    CHECK(buffer.size() == 8192U);
+    auto const *const memory = buffer.data();
+
+    SECTION("with the same size class")
+    {
+        buffer.resize(100U);
+        subject.recycle(std::move(buffer));
+
+        auto reuseRx = subject.lease(8000U);
+        REQUIRE(reuseRx);
+        CHECK(reuseRx.assume_value().data() == memory);
+        CHECK(reuseRx.assume_value().size() == 8192U);
+    }
+    SECTION("but not with a larger size class")
+    {
+        subject.recycle(std::move(buffer));
+
+        auto otherRx = subject.lease(8193U);
+        REQUIRE(otherRx);
+        CHECK(otherRx.assume_value().data() != memory);
+        CHECK(otherRx.assume_value().size() == 16384U);
+    }
+    SECTION("but serve oversized requests with fresh allocations")
+    {
+        auto largeRx = subject.lease(dp::buffer_pool::max_buffer_size + 1U);
+        REQUIRE(largeRx);
+        CHECK(largeRx.assume_value().size()
+              == dp::buffer_pool::max_buffer_size + 1U);
+    }
+}
+
+TEST_CASE("buffer_pool should not touch the bytes of recycled buffers")
+{
+    dp::buffer_pool subject(2U);
+
+    auto leaseRx = subject.lease(5000U);
+    REQUIRE(leaseRx);
+    auto buffer = std::move(leaseRx).assume_value();
+    std::ranges::fill(buffer, std::byte{0xa5});
+    // like dynamic_memory_output_stream::written() &&
+    buffer.resize(100U);
+    subject.recycle(std::move(buffer));
+
+    auto reuseRx = subject.lease(5000U);
+    REQUIRE(reuseRx);
+    auto const &reused = reuseRx.assume_value();
+    REQUIRE(reused.size() == 8192U);
+    CHECK(std::ranges::all_of(
+            reused, [](std::byte const b) { return b == std::byte{0xa5}; }));
+}
+
+TEST_CASE("buffer_cache should exchange buffers with its pool")
+{
+    dp::buffer_pool pool;
+    std::vector<std::byte const *> memory;
+    {
+        dp::buffer_cache subject(pool);
+        std::vector<dp::buffer_cache::buffer_type> buffers;
+        for (std::size_t i = 0U; i < dp::buffer_cache::cache_size + 1U; ++i)
+        {
+            auto leaseRx = subject.lease(1U);
+            REQUIRE(leaseRx);
+            memory.push_back(leaseRx.assume_value().data());
+            buffers.push_back(std::move(leaseRx).assume_value());
+        }
+        for (auto &buffer : buffers)
+        {
+            subject.recycle(std::move(buffer));
+        }
+    }
+
+    std::vector<dp::buffer_pool::buffer_type> reclaimed(memory.size() + 1U);
+    CHECK(pool.take(0U, reclaimed) == memory.size());
+}
+
+TEST_CASE("buffer_cache can be used concurrently")
+{
+    constexpr int numThreads = 4;
+    constexpr int numIterations = 256;
+    dp::buffer_pool pool(8U);
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&pool] {
+            dp::buffer_cache cache(pool);
+            for (int i = 0; i < numIterations; ++i)
+            {
+                auto leaseRx = cache.lease(static_cast<std::size_t>(i) * 64U);
+                if (leaseRx)
+                {
+                    cache.recycle(std::move(leaseRx).assume_value());
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST_CASE("message_size_hint should follow the encoded sizes")
+{
+    dp::message_size_hint subject;
+    CHECK(subject.predict() == 0U);
+
+    subject.observe(800U);
+    CHECK(subject.predict() == 800U);
+    subject.observe(1000U);
+    CHECK(subject.predict() == 1000U);
+    subject.observe(10U);
+    CHECK(subject.predict() == 875U);
+}
+
+TEST_CASE("dynamic_memory_output_stream can use pooled buffers")
+{
+    std::vector<int> values(1024U);
+    std::iota(values.begin(), values.end(), 0x10000);
+
+    dp::buffer_pool pool;
+    dp::buffer_cache cache(pool);
+    dp::message_size_hint hint;
+
+    std::byte const *memory = nullptr;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto leaseRx = cache.lease(hint);
+        REQUIRE(leaseRx);
+        dp::dynamic_memory_output_stream out(std::move(leaseRx).assume_value());
+        REQUIRE(dp::encode(out, values));
+
+        auto buffer = std::move(out).written();
+        if (i > 1)
+        {
+            // the hint prevents any further reallocation
+            CHECK(buffer.data() == memory);
+        }
+        memory = buffer.data();
+        cache.recycle(std::move(buffer), hint);
+        CHECK(hint.predict() >= values.size() * 5U);
+    }
+}
+
+} // namespace dp_tests
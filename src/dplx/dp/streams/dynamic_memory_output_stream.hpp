@@ -8,6 +8,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -23,12 +24,63 @@
 namespace dplx::dp
 {
 
-template <typename Allocator = std::allocator<std::byte>>
+/**
+ * Grows a buffer by `Numerator / Denominator` rounded up to a multiple of
+ * `Granularity` (which must be a power of two). Buffers never exceed
+ * `MaxSize` bytes.
+ */
+template <std::size_t Numerator = 3U,
+          std::size_t Denominator = 2U,
+          std::size_t Granularity = 4096U,
+          std::size_t MaxSize = SIZE_MAX>
+struct geometric_growth_policy
+{
+    static_assert(Numerator > Denominator);
+    static_assert(Denominator > 0U);
+    static_assert((Granularity & (Granularity - 1U)) == 0U);
+    static_assert(MaxSize >= Granularity);
+
+    static constexpr std::size_t max_size = MaxSize;
+
+    /**
+     * Returns the capacity to allocate for `required` bytes; `required` must
+     * not exceed `max_size`.
+     */
+    [[nodiscard]] static constexpr auto
+    buffer_size_for(std::size_t const required) noexcept -> std::size_t
+    {
+        constexpr std::size_t overflowThreshold
+                = (max_size - Granularity) / Numerator * Denominator;
+        if (required >= overflowThreshold) [[unlikely]]
+        {
+            return max_size;
+        }
+
+        auto acc = Granularity;
+        while (acc < required)
+        {
+            acc = cncr::round_up_p2(acc / Denominator * Numerator,
+                                    Granularity);
+        }
+        return acc < max_size ? acc : max_size;
+    }
+};
+
+/**
+ * An output stream writing into a growing `std::vector`.
+ *
+ * @tparam Allocator The vector allocator. `default_init_allocator` skips
+ *         the zero filling of grown storage and `huge_page_allocator`
+ *         provides huge page backed memory.
+ * @tparam GrowthPolicy Determines the capacity for a requested size and
+ *         the maximum buffer size, see `geometric_growth_policy`.
+ */
+template <typename Allocator = std::allocator<std::byte>,
+          typename GrowthPolicy = geometric_growth_policy<>>
 // the class is final and none of its base classes have public destructors
 // NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
 class dynamic_memory_output_stream final : public output_buffer
 {
-    static constexpr std::size_t page_size = 4096U;
     using alloc_traits = std::allocator_traits<Allocator>;
 
     using buffer_type = std::vector<
@@ -74,7 +126,12 @@ private:
     try
     {
         auto const offset = static_cast<std::size_t>(data() - mBuffer.data());
-        mBuffer.resize(buffer_size_for(mBuffer.size() + requestedSize));
+        auto const requiredSize = offset + requestedSize;
+        if (requiredSize < offset || requiredSize > GrowthPolicy::max_size)
+        {
+            return errc::buffer_size_exceeded;
+        }
+        mBuffer.resize(GrowthPolicy::buffer_size_for(requiredSize));
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         output_buffer::reset(mBuffer.data() + offset, mBuffer.size() - offset);
         return outcome::success();
@@ -92,22 +149,9 @@ private:
         commit_written(srcSize);
         return outcome::success();
     }
-
-    [[nodiscard]] static auto buffer_size_for(std::size_t required) noexcept
-            -> std::size_t
+    auto do_retained_output() noexcept -> std::span<std::byte> override
     {
-        constexpr std::size_t overflowThreshold = SIZE_MAX / 3 * 2 - page_size;
-        if (required >= overflowThreshold) [[unlikely]]
-        {
-            return SIZE_MAX;
-        }
-
-        auto acc = page_size;
-        while (acc < required)
-        {
-            acc = cncr::round_up_p2(acc * 3 / 2, page_size);
-        }
-        return acc;
+        return std::span<std::byte>(mBuffer).first(mBuffer.size() - size());
     }
 };
 
@@ -14,6 +14,7 @@
 #include <dplx/dp/detail/workaround.hpp>
 
 #include "blob_matcher.hpp"
+#include "dplx/dp/streams/allocators.hpp"
 #include "test_utils.hpp"
 
 namespace dp_tests
@@ -71,4 +72,63 @@ TEST_CASE("dynamic_memory_output_stream can be constructed from an existing "
     CHECK(subject.empty()); // NOLINT(bugprone-use-after-move)
 }
 
+TEST_CASE("geometric_growth_policy should round to its granularity")
+{
+    using policy = dp::geometric_growth_policy<2U, 1U, 64U, 1000U>;
+    CHECK(policy::buffer_size_for(0U) == 64U);
+    CHECK(policy::buffer_size_for(64U) == 64U);
+    CHECK(policy::buffer_size_for(65U) == 128U);
+    CHECK(policy::buffer_size_for(300U) == 512U);
+    CHECK(policy::buffer_size_for(513U) == 1000U);
+    CHECK(policy::buffer_size_for(1000U) == 1000U);
+
+    using default_policy = dp::geometric_growth_policy<>;
+    CHECK(default_policy::buffer_size_for(4097U) == 8192U);
+    CHECK(default_policy::buffer_size_for(SIZE_MAX) == SIZE_MAX);
+}
+
+TEST_CASE("dynamic_memory_output_stream should respect the maximum size")
+{
+    dp::dynamic_memory_output_stream<
+            std::allocator<std::byte>,
+            dp::geometric_growth_policy<3U, 2U, 64U, 256U>>
+            subject;
+
+    REQUIRE(subject.ensure_size(100U));
+    CHECK(subject.size() == 128U);
+    subject.commit_written(100U);
+    REQUIRE(subject.ensure_size(156U));
+    CHECK(subject.size() == 156U);
+    CHECK(subject.ensure_size(157U).error() == dp::errc::buffer_size_exceeded);
+}
+
+TEST_CASE("dynamic_memory_output_stream can use a default_init_allocator")
+{
+    dp::dynamic_memory_output_stream<dp::default_init_allocator<std::byte>>
+            subject;
+
+    std::array<std::byte, 3U> const payload{std::byte{1}, std::byte{2},
+                                            std::byte{3}};
+    REQUIRE(subject.bulk_write(payload.data(), payload.size()));
+    REQUIRE(subject.ensure_size(8192U));
+    CHECK_BLOB_EQ(subject.written(), payload);
+
+    std::vector<std::byte, dp::default_init_allocator<std::byte>> const
+            written = std::move(subject).written();
+    CHECK(written.size() == payload.size());
+}
+
+TEST_CASE("dynamic_memory_output_stream can use a huge_page_allocator")
+{
+    constexpr auto hugePageSize
+            = dp::huge_page_allocator<std::byte>::huge_page_size;
+    dp::dynamic_memory_output_stream<dp::huge_page_allocator<std::byte>>
+            subject;
+
+    REQUIRE(subject.ensure_size(hugePageSize + 1U));
+    CHECK(subject.size() >= hugePageSize + 1U);
+    CHECK(reinterpret_cast<std::uintptr_t>(subject.data()) % hugePageSize
+          == 0U);
+}
+
 } // namespace dp_tests
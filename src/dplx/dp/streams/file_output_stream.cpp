@@ -0,0 +1,138 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/file_output_stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace dplx::dp
+{
+
+file_output_stream::file_output_stream(file_output_stream &&other) noexcept
+    : output_buffer(static_cast<output_buffer &&>(other))
+    , mFile(std::move(other.mFile))
+    , mBuffer(std::move(other.mBuffer))
+    , mBufferSize(std::exchange(other.mBufferSize, 0U))
+    , mFlushedSize(std::exchange(other.mFlushedSize, 0U))
+    , mSyncData(other.mSyncData)
+{
+    other.reset();
+}
+
+auto file_output_stream::operator=(file_output_stream &&other) noexcept
+        -> file_output_stream &
+{
+    if (this != &other)
+    {
+        output_buffer::operator=(static_cast<output_buffer &&>(other));
+        mFile = std::move(other.mFile);
+        mBuffer = std::move(other.mBuffer);
+        mBufferSize = std::exchange(other.mBufferSize, 0U);
+        mFlushedSize = std::exchange(other.mFlushedSize, 0U);
+        mSyncData = other.mSyncData;
+        other.reset();
+    }
+    return *this;
+}
+
+file_output_stream::file_output_stream(detail::posix_file &&file,
+                                       std::unique_ptr<std::byte[]> &&buffer,
+                                       std::size_t const bufferSize,
+                                       bool const syncData) noexcept
+    : output_buffer(buffer.get(), bufferSize)
+    , mFile(std::move(file))
+    , mBuffer(std::move(buffer))
+    , mBufferSize(bufferSize)
+    , mSyncData(syncData)
+{
+}
+
+auto file_output_stream::create(std::filesystem::path const &path,
+                                file_output_options const &options) noexcept
+        -> result<file_output_stream>
+{
+    auto const bufferSize = std::max<std::size_t>(options.buffer_size,
+                                                  minimum_output_buffer_size);
+    std::unique_ptr<std::byte[]> buffer;
+    try
+    {
+        buffer = std::make_unique_for_overwrite<std::byte[]>(bufferSize);
+    }
+    catch (std::bad_alloc const &)
+    {
+        return system_error::errc::not_enough_memory;
+    }
+
+    DPLX_TRY(auto &&file, detail::posix_file::open(
+                                  path, detail::file_open_mode::write_truncate));
+    return file_output_stream(std::move(file), std::move(buffer), bufferSize,
+                              options.sync_data);
+}
+
+auto file_output_stream::flush() noexcept -> result<void>
+{
+    auto const stagedSize = mBufferSize - size();
+    if (stagedSize == 0U)
+    {
+        return outcome::success();
+    }
+    DPLX_TRY(mFile.write(mBuffer.get(), stagedSize));
+    mFlushedSize += stagedSize;
+    output_buffer::reset(mBuffer.get(), mBufferSize);
+    return outcome::success();
+}
+
+auto file_output_stream::do_grow(size_type const requestedSize) noexcept
+        -> result<void>
+{
+    if (requestedSize > mBufferSize)
+    {
+        return errc::buffer_size_exceeded;
+    }
+    return flush();
+}
+
+auto file_output_stream::do_bulk_write(std::byte const *const src,
+                                       std::size_t const srcSize) noexcept
+        -> result<void>
+{
+    // output_buffer::bulk_write() has already filled the staging buffer
+    if (srcSize < mBufferSize)
+    {
+        DPLX_TRY(flush());
+        std::memcpy(mBuffer.get(), src, srcSize);
+        commit_written(srcSize);
+        return outcome::success();
+    }
+
+    // large payloads bypass the staging buffer
+    auto const stagedSize = mBufferSize - size();
+    std::array<std::span<std::byte const>, 2U> const buffers{
+            std::span<std::byte const>(mBuffer.get(), stagedSize),
+            std::span<std::byte const>(src, srcSize),
+    };
+    DPLX_TRY(mFile.write_vectored(buffers));
+    mFlushedSize += stagedSize + srcSize;
+    output_buffer::reset(mBuffer.get(), mBufferSize);
+    return outcome::success();
+}
+
+auto file_output_stream::do_sync_output() noexcept -> result<void>
+{
+    DPLX_TRY(flush());
+    if (mSyncData)
+    {
+        DPLX_TRY(mFile.sync_data());
+    }
+    return outcome::success();
+}
+
+} // namespace dplx::dp
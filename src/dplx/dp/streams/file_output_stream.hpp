@@ -0,0 +1,98 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include <dplx/dp/detail/posix_file.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/output_buffer.hpp>
+
+namespace dplx::dp
+{
+
+struct file_output_options
+{
+    /**
+     * The size of the staging buffer which is allocated once on creation.
+     * It bounds the memory usage regardless of the encoded item size.
+     */
+    std::size_t buffer_size = 256U * 1024U;
+    /**
+     * Whether `sync_output()` additionally flushes the file content to the
+     * storage device (`fdatasync()`).
+     */
+    bool sync_data = false;
+};
+
+/**
+ * An output stream which writes to a file through a fixed size staging
+ * buffer. Writes which don't fit into the staging buffer are passed on to
+ * the file together with the staged content via a single `writev()`.
+ *
+ * @note Staged content is _not_ written by the destructor, i.e. the stream
+ *       must be synced with `sync_output()` in order to persist it.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class file_output_stream final : public output_buffer
+{
+    detail::posix_file mFile;
+    std::unique_ptr<std::byte[]> mBuffer;
+    std::size_t mBufferSize{0U};
+    std::uint64_t mFlushedSize{0U};
+    bool mSyncData{false};
+
+public:
+    ~file_output_stream() noexcept = default;
+    file_output_stream() noexcept = default;
+
+    file_output_stream(file_output_stream const &) = delete;
+    auto operator=(file_output_stream const &) -> file_output_stream & = delete;
+
+    file_output_stream(file_output_stream &&other) noexcept;
+    auto operator=(file_output_stream &&other) noexcept
+            -> file_output_stream &;
+
+    /**
+     * Creates (or truncates) the file and allocates the staging buffer.
+     */
+    static auto create(std::filesystem::path const &path,
+                       file_output_options const &options = {}) noexcept
+            -> result<file_output_stream>;
+
+    /**
+     * The number of bytes written into the stream so far (including the
+     * currently staged bytes).
+     */
+    [[nodiscard]] auto written_size() const noexcept -> std::uint64_t
+    {
+        return mFlushedSize + (mBufferSize - size());
+    }
+
+    /**
+     * Writes the staged content to the file.
+     */
+    auto flush() noexcept -> result<void>;
+
+private:
+    file_output_stream(detail::posix_file &&file,
+                       std::unique_ptr<std::byte[]> &&buffer,
+                       std::size_t bufferSize,
+                       bool syncData) noexcept;
+
+    auto do_grow(size_type requestedSize) noexcept -> result<void> override;
+    auto do_bulk_write(std::byte const *src, std::size_t srcSize) noexcept
+            -> result<void> override;
+    auto do_sync_output() noexcept -> result<void> override;
+};
+
+} // namespace dplx::dp
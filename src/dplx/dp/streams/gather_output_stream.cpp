@@ -0,0 +1,159 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/gather_output_stream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace dplx::dp
+{
+
+gather_output_stream::gather_output_stream(
+        gather_output_stream &&other) noexcept
+    : output_buffer(static_cast<output_buffer &&>(other))
+    , mChunks(std::move(other.mChunks))
+    , mNextChunk(std::exchange(other.mNextChunk, 0U))
+    , mSegments(std::move(other.mSegments))
+    , mSegmentsSize(std::exchange(other.mSegmentsSize, 0U))
+    , mRunStart(std::exchange(other.mRunStart, nullptr))
+    , mChunkEnd(std::exchange(other.mChunkEnd, nullptr))
+    , mOptions(other.mOptions)
+{
+    other.reset();
+}
+
+auto gather_output_stream::operator=(gather_output_stream &&other) noexcept
+        -> gather_output_stream &
+{
+    if (this != &other)
+    {
+        output_buffer::operator=(static_cast<output_buffer &&>(other));
+        mChunks = std::move(other.mChunks);
+        mNextChunk = std::exchange(other.mNextChunk, 0U);
+        mSegments = std::move(other.mSegments);
+        mSegmentsSize = std::exchange(other.mSegmentsSize, 0U);
+        mRunStart = std::exchange(other.mRunStart, nullptr);
+        mChunkEnd = std::exchange(other.mChunkEnd, nullptr);
+        mOptions = other.mOptions;
+        other.reset();
+    }
+    return *this;
+}
+
+auto gather_output_stream::segments() noexcept
+        -> result<std::span<std::span<std::byte const> const>>
+{
+    DPLX_TRY(close_run());
+    return std::span<std::span<std::byte const> const>(mSegments);
+}
+
+auto gather_output_stream::written_size() const noexcept -> std::uint64_t
+{
+    if (mRunStart == nullptr)
+    {
+        return mSegmentsSize;
+    }
+    auto const runSize = static_cast<std::size_t>(mChunkEnd - mRunStart);
+    return mSegmentsSize + (runSize - size());
+}
+
+void gather_output_stream::clear() noexcept
+{
+    mSegments.clear();
+    mSegmentsSize = 0U;
+    mNextChunk = 0U;
+    mRunStart = nullptr;
+    mChunkEnd = nullptr;
+    output_buffer::reset();
+}
+
+auto gather_output_stream::close_run() noexcept -> result<void>
+try
+{
+    if (mRunStart != nullptr && mRunStart != data())
+    {
+        auto const runSize = static_cast<std::size_t>(data() - mRunStart);
+        mSegments.emplace_back(mRunStart, runSize);
+        mSegmentsSize += runSize;
+        mRunStart = data();
+    }
+    return outcome::success();
+}
+catch (std::bad_alloc const &)
+{
+    return system_error::errc::not_enough_memory;
+}
+
+auto gather_output_stream::acquire_chunk(size_type const minSize) noexcept
+        -> result<void>
+try
+{
+    // reuse the next chunk retained by clear() if it is large enough
+    if (mNextChunk == mChunks.size() || mChunks[mNextChunk].size < minSize)
+    {
+        auto const chunkSize = std::max(minSize, mOptions.arena_chunk_size);
+        mChunks.insert(
+                mChunks.begin() + static_cast<std::ptrdiff_t>(mNextChunk),
+                arena_chunk{
+                        std::make_unique_for_overwrite<std::byte[]>(chunkSize),
+                        chunkSize});
+    }
+
+    auto &chunk = mChunks[mNextChunk];
+    mNextChunk += 1U;
+    mRunStart = chunk.data.get();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    mChunkEnd = chunk.data.get() + chunk.size;
+    output_buffer::reset(chunk.data.get(), chunk.size);
+    return outcome::success();
+}
+catch (std::bad_alloc const &)
+{
+    return system_error::errc::not_enough_memory;
+}
+
+auto gather_output_stream::do_grow(size_type const requestedSize) noexcept
+        -> result<void>
+{
+    DPLX_TRY(close_run());
+    return acquire_chunk(requestedSize);
+}
+
+auto gather_output_stream::do_bulk_write(std::byte const *const src,
+                                         std::size_t const srcSize) noexcept
+        -> result<void>
+{
+    // output_buffer::bulk_write() has already filled the current chunk
+    if (srcSize >= mOptions.borrow_threshold)
+    {
+        DPLX_TRY(close_run());
+        try
+        {
+            mSegments.emplace_back(src, srcSize);
+            mSegmentsSize += srcSize;
+        }
+        catch (std::bad_alloc const &)
+        {
+            return system_error::errc::not_enough_memory;
+        }
+        return outcome::success();
+    }
+
+    DPLX_TRY(gather_output_stream::do_grow(srcSize));
+    std::memcpy(data(), src, srcSize);
+    commit_written(srcSize);
+    return outcome::success();
+}
+
+auto gather_output_stream::do_sync_output() noexcept -> result<void>
+{
+    return close_run();
+}
+
+} // namespace dplx::dp
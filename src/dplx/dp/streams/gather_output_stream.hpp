@@ -0,0 +1,111 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/output_buffer.hpp>
+
+namespace dplx::dp
+{
+
+struct gather_output_options
+{
+    /**
+     * The (minimum) size of each arena chunk which stores item heads and
+     * small payloads.
+     */
+    std::size_t arena_chunk_size = 16U * 1024U;
+    /**
+     * Bulk writes of at least this many bytes are referenced instead of being
+     * copied into the arena.
+     */
+    std::size_t borrow_threshold = 4U * 1024U;
+};
+
+/**
+ * An output stream which produces a list of segments suitable for vectored
+ * I/O (`writev()`/`sendmsg()`). Item heads and small payloads are copied into
+ * an owned arena whereas the bulk of large payloads is merely referenced.
+ *
+ * @note `output_buffer::bulk_write()` always fills the remaining arena chunk
+ *       before the rest of a payload is borrowed, i.e. the copied prefix is
+ *       bounded by `arena_chunk_size`.
+ *
+ * @warning Borrowed payloads must outlive the usage of `segments()`.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class gather_output_stream final : public output_buffer
+{
+    struct arena_chunk
+    {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<arena_chunk> mChunks;
+    std::size_t mNextChunk{0U};
+    std::vector<std::span<std::byte const>> mSegments;
+    std::uint64_t mSegmentsSize{0U};
+    std::byte *mRunStart{nullptr};
+    std::byte *mChunkEnd{nullptr};
+    gather_output_options mOptions;
+
+public:
+    ~gather_output_stream() noexcept = default;
+    gather_output_stream() noexcept = default;
+
+    gather_output_stream(gather_output_stream const &) = delete;
+    auto operator=(gather_output_stream const &)
+            -> gather_output_stream & = delete;
+
+    gather_output_stream(gather_output_stream &&other) noexcept;
+    auto operator=(gather_output_stream &&other) noexcept
+            -> gather_output_stream &;
+
+    explicit gather_output_stream(gather_output_options const &options) noexcept
+        : output_buffer()
+        , mOptions(options)
+    {
+    }
+
+    /**
+     * Returns the written content in order. Arena and borrowed segments may
+     * be interleaved arbitrarily. Writing to the stream invalidates the
+     * returned span.
+     */
+    [[nodiscard]] auto segments() noexcept
+            -> result<std::span<std::span<std::byte const> const>>;
+
+    /**
+     * The number of bytes written so far (including borrowed payloads).
+     */
+    [[nodiscard]] auto written_size() const noexcept -> std::uint64_t;
+
+    /**
+     * Drops all segments, but retains the arena memory for reuse.
+     */
+    void clear() noexcept;
+
+private:
+    auto close_run() noexcept -> result<void>;
+    auto acquire_chunk(size_type minSize) noexcept -> result<void>;
+
+    auto do_grow(size_type requestedSize) noexcept -> result<void> override;
+    auto do_bulk_write(std::byte const *src, std::size_t srcSize) noexcept
+            -> result<void> override;
+    auto do_sync_output() noexcept -> result<void> override;
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,145 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/gather_output_stream.hpp"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(std::derived_from<dp::gather_output_stream, dp::output_buffer>);
+static_assert(dp::output_stream<dp::gather_output_stream &>);
+static_assert(std::movable<dp::gather_output_stream>);
+static_assert(!std::copyable<dp::gather_output_stream>);
+
+namespace
+{
+
+auto make_payload(std::size_t const size) -> std::vector<std::byte>
+{
+    std::vector<std::byte> payload(size);
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        payload[i] = static_cast<std::byte>(i % 251U);
+    }
+    return payload;
+}
+
+auto concat(std::span<std::span<std::byte const> const> segments)
+        -> std::vector<std::byte>
+{
+    std::vector<std::byte> content;
+    for (auto const segment : segments)
+    {
+        content.insert(content.end(), segment.begin(), segment.end());
+    }
+    return content;
+}
+
+} // namespace
+
+TEST_CASE("gather_output_stream should be default constructible")
+{
+    dp::gather_output_stream subject;
+    CHECK(subject.empty());
+    CHECK(subject.written_size() == 0U);
+
+    auto segmentsRx = subject.segments();
+    REQUIRE(segmentsRx);
+    CHECK(segmentsRx.assume_value().empty());
+
+    SECTION("and growable")
+    {
+        REQUIRE(subject.ensure_size(1U));
+        CHECK(!subject.empty());
+        CHECK(subject.data() != nullptr);
+    }
+}
+
+TEST_CASE("gather_output_stream should copy small writes into its arena")
+{
+    constexpr std::size_t chunkSize = 64U;
+    dp::gather_output_stream subject(
+            {.arena_chunk_size = chunkSize, .borrow_threshold = 32U});
+
+    auto const payload = make_payload(chunkSize * 3U);
+    for (std::size_t i = 0U; i < payload.size(); i += 16U)
+    {
+        REQUIRE(subject.bulk_write(payload.data() + i, 16U));
+    }
+    CHECK(subject.written_size() == payload.size());
+
+    auto segmentsRx = subject.segments();
+    REQUIRE(segmentsRx);
+    auto const segments = segmentsRx.assume_value();
+    CHECK(segments.size() == 3U);
+    CHECK_BLOB_EQ(concat(segments), payload);
+}
+
+TEST_CASE("gather_output_stream should borrow large payloads")
+{
+    constexpr std::size_t chunkSize = 64U;
+    dp::gather_output_stream subject(
+            {.arena_chunk_size = chunkSize, .borrow_threshold = 32U});
+
+    auto const payload = make_payload(chunkSize * 4U);
+    REQUIRE(subject.ensure_size(1U));
+    subject.commit_written(1U);
+    REQUIRE(subject.bulk_write(payload.data(), payload.size()));
+    CHECK(subject.written_size() == payload.size() + 1U);
+
+    auto segmentsRx = subject.segments();
+    REQUIRE(segmentsRx);
+    auto const segments = segmentsRx.assume_value();
+    REQUIRE(segments.size() == 2U);
+    // the remaining arena chunk has been filled with the payload prefix
+    CHECK(segments[0].size() == chunkSize);
+    CHECK(segments[1].data() == payload.data() + (chunkSize - 1U));
+    CHECK(segments[1].size() == payload.size() - (chunkSize - 1U));
+    auto const content = concat(segments);
+    CHECK_BLOB_EQ(std::span(content).subspan(1U), payload);
+
+    SECTION("and reuse its arena after being cleared")
+    {
+        auto const *const chunk = segments[0].data();
+        subject.clear();
+        CHECK(subject.written_size() == 0U);
+
+        REQUIRE(subject.ensure_size(1U));
+        CHECK(subject.data() == chunk);
+    }
+}
+
+TEST_CASE("gather_output_stream can be encoded into")
+{
+    std::vector<std::vector<std::byte>> values{
+            make_payload(3U),    make_payload(5000U), make_payload(17U),
+            make_payload(8192U), make_payload(0U),    make_payload(40000U),
+    };
+
+    dp::dynamic_memory_output_stream<> expected;
+    REQUIRE(dp::encode(expected, values));
+
+    dp::gather_output_stream subject;
+    REQUIRE(dp::encode(subject, values));
+    CHECK(subject.written_size() == expected.written_size());
+
+    auto segmentsRx = subject.segments();
+    REQUIRE(segmentsRx);
+    CHECK_BLOB_EQ(concat(segmentsRx.assume_value()), expected.written());
+}
+
+} // namespace dp_tests
@@ -133,13 +133,16 @@ public:
     auto require_input(size_type const requiredSize) noexcept -> result<void>
     {
         result<void> rx = outcome::success();
-        if (requiredSize > mInputSize)
+        if (mInputBufferSize < requiredSize) [[unlikely]]
         {
-            rx = errc::end_of_stream;
-        }
-        else if (mInputBufferSize < requiredSize)
-        {
-            rx = do_require_input(requiredSize);
+            if (requiredSize > mInputSize)
+            {
+                rx = errc::end_of_stream;
+            }
+            else
+            {
+                rx = do_require_input(requiredSize);
+            }
         }
         return rx;
     }
@@ -164,7 +167,6 @@ public:
             return errc::end_of_stream;
         }
 
-        mInputSize -= mInputBufferSize;
         auto const remaining = amount - mInputBufferSize;
         reset();
         return do_discard_input(remaining);
@@ -192,6 +192,7 @@ TEST_CASE("input_buffer can be constructed with an initial buffer")
 
         CHECK(subject.discard_input_calls == 1);
         CHECK(subject.empty());
+        CHECK(subject.input_size() == 1U);
         CHECK(subject.last_discard_input_param == 1U);
     }
 
@@ -0,0 +1,236 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/mapped_file_input_stream.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <status-code/posix_code.hpp>
+
+#include <dplx/cncr/math_supplement.hpp>
+
+namespace dplx::dp
+{
+
+namespace
+{
+
+auto page_size() noexcept -> std::size_t
+{
+    static std::size_t const pageSize
+            = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return pageSize;
+}
+
+} // namespace
+
+mapped_file_input_stream::~mapped_file_input_stream() noexcept
+{
+    unmap();
+}
+
+mapped_file_input_stream::mapped_file_input_stream(
+        mapped_file_input_stream &&other) noexcept
+    : input_buffer(static_cast<input_buffer &&>(other))
+    , mFile(std::move(other.mFile))
+    , mMapping(std::exchange(other.mMapping, nullptr))
+    , mMappingSize(std::exchange(other.mMappingSize, 0U))
+    , mMappingOffset(std::exchange(other.mMappingOffset, 0U))
+    , mFileSize(std::exchange(other.mFileSize, 0U))
+    , mOptions(other.mOptions)
+{
+    other.reset(nullptr, 0U, 0U);
+}
+
+auto mapped_file_input_stream::operator=(
+        mapped_file_input_stream &&other) noexcept -> mapped_file_input_stream &
+{
+    if (this != &other)
+    {
+        unmap();
+        input_buffer::operator=(static_cast<input_buffer &&>(other));
+        mFile = std::move(other.mFile);
+        mMapping = std::exchange(other.mMapping, nullptr);
+        mMappingSize = std::exchange(other.mMappingSize, 0U);
+        mMappingOffset = std::exchange(other.mMappingOffset, 0U);
+        mFileSize = std::exchange(other.mFileSize, 0U);
+        mOptions = other.mOptions;
+        other.reset(nullptr, 0U, 0U);
+    }
+    return *this;
+}
+
+mapped_file_input_stream::mapped_file_input_stream(
+        detail::posix_file &&file,
+        std::uint64_t const fileSize,
+        mapped_file_options const &options) noexcept
+    : input_buffer(nullptr, 0U, fileSize)
+    , mFile(std::move(file))
+    , mFileSize(fileSize)
+    , mOptions(options)
+{
+}
+
+auto mapped_file_input_stream::open(std::filesystem::path const &path,
+                                    mapped_file_options const &options) noexcept
+        -> result<mapped_file_input_stream>
+{
+    DPLX_TRY(auto &&file,
+             detail::posix_file::open(path, detail::file_open_mode::read));
+    DPLX_TRY(auto const fileSize, file.size());
+
+    auto effectiveOptions = options;
+    if (effectiveOptions.window_size != 0U)
+    {
+        effectiveOptions.window_size
+                = cncr::round_up_p2(effectiveOptions.window_size, page_size());
+        if (effectiveOptions.window_size >= fileSize)
+        {
+            effectiveOptions.window_size = 0U;
+        }
+    }
+    else if (fileSize > SIZE_MAX)
+    {
+        // the file doesn't fit into the address space
+        return system_error::errc::value_too_large;
+    }
+
+    mapped_file_input_stream stream(std::move(file), fileSize,
+                                    effectiveOptions);
+    DPLX_TRY(stream.map_window(0U, 0U));
+    return stream;
+}
+
+auto mapped_file_input_stream::map_window(std::uint64_t const position,
+                                          std::size_t const requiredSize) noexcept
+        -> result<void>
+{
+    auto const pageSize = page_size();
+    auto const base = position - position % pageSize;
+    auto const lead = static_cast<std::size_t>(position - base);
+
+    std::uint64_t length = mFileSize - base;
+    if (mOptions.window_size != 0U)
+    {
+        length = std::min<std::uint64_t>(
+                length,
+                std::max(mOptions.window_size,
+                         cncr::round_up_p2(lead + requiredSize, pageSize)));
+    }
+    if (length == 0U)
+    {
+        unmap();
+        reset(nullptr, 0U, mFileSize - position);
+        return outcome::success();
+    }
+
+    void *const mapping = ::mmap(nullptr, static_cast<std::size_t>(length),
+                                 PROT_READ, MAP_PRIVATE,
+                                 mFile.native_handle(),
+                                 static_cast<::off_t>(base));
+    if (mapping == MAP_FAILED) // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    {
+        return system_error::posix_code::current();
+    }
+    // the old window must stay valid until the new one has been established
+    unmap();
+    mMapping = static_cast<std::byte *>(mapping);
+    mMappingSize = static_cast<std::size_t>(length);
+    mMappingOffset = base;
+    apply_access_hints();
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    reset(mMapping + lead, mMappingSize - lead, mFileSize - position);
+    return outcome::success();
+}
+
+auto mapped_file_input_stream::seek(std::uint64_t const position) noexcept
+        -> result<void>
+{
+    if (mMapping != nullptr && mMappingOffset <= position
+        && position - mMappingOffset < mMappingSize)
+    {
+        auto const offset = static_cast<std::size_t>(position - mMappingOffset);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        reset(mMapping + offset, mMappingSize - offset, mFileSize - position);
+        return outcome::success();
+    }
+    return map_window(position, 0U);
+}
+
+void mapped_file_input_stream::apply_access_hints() const noexcept
+{
+    int advice = POSIX_MADV_NORMAL;
+    switch (mOptions.access)
+    {
+    case file_access_pattern::normal:
+        break;
+    case file_access_pattern::sequential:
+        advice = POSIX_MADV_SEQUENTIAL;
+        break;
+    case file_access_pattern::random:
+        advice = POSIX_MADV_RANDOM;
+        break;
+    }
+    // the hints are advisory, therefore failures are inconsequential
+    (void)::posix_madvise(mMapping, mMappingSize, advice);
+    if (mOptions.will_need)
+    {
+        (void)::posix_madvise(mMapping, mMappingSize, POSIX_MADV_WILLNEED);
+    }
+#if defined(MADV_HUGEPAGE)
+    if (mOptions.huge_pages)
+    {
+        (void)::madvise(mMapping, mMappingSize, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+void mapped_file_input_stream::unmap() noexcept
+{
+    if (mMapping != nullptr)
+    {
+        (void)::munmap(mMapping, mMappingSize);
+        mMapping = nullptr;
+        mMappingSize = 0U;
+        mMappingOffset = 0U;
+    }
+}
+
+auto mapped_file_input_stream::do_require_input(
+        size_type const requiredSize) noexcept -> result<void>
+{
+    if (mOptions.window_size == 0U)
+    {
+        // the whole file is mapped, i.e. input_size() == size() which has
+        // already been checked by require_input()
+        return errc::end_of_stream;
+    }
+    return map_window(position(), requiredSize);
+}
+
+auto mapped_file_input_stream::do_discard_input(size_type const amount) noexcept
+        -> result<void>
+{
+    // input_buffer::discard_input() already consumed the buffered bytes and
+    // checked the amount against input_size()
+    return seek(position() + amount);
+}
+
+auto mapped_file_input_stream::do_bulk_read(std::byte *const dest,
+                                            std::size_t const amount) noexcept
+        -> result<void>
+{
+    auto const readPosition = position();
+    DPLX_TRY(mFile.read_at(dest, amount, readPosition));
+    return seek(readPosition + amount);
+}
+
+} // namespace dplx::dp
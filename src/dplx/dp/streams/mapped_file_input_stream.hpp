@@ -0,0 +1,118 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include <dplx/dp/detail/posix_file.hpp>
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/input_buffer.hpp>
+
+namespace dplx::dp
+{
+
+enum class file_access_pattern : unsigned
+{
+    normal,
+    sequential,
+    random,
+};
+
+struct mapped_file_options
+{
+    /**
+     * Forwarded to the kernel via `posix_madvise()` for each mapping.
+     */
+    file_access_pattern access = file_access_pattern::sequential;
+    /**
+     * Asks the kernel to start reading in each mapping immediately.
+     */
+    bool will_need = true;
+    /**
+     * Requests transparent huge pages for the mapping where supported. This is
+     * purely advisory and silently ignored on other platforms.
+     */
+    bool huge_pages = false;
+    /**
+     * The maximum number of bytes which are mapped at once; it is rounded up
+     * to a multiple of the page size. Zero maps the whole file with a single
+     * mapping in which case no virtual function will ever be called during
+     * decoding.
+     */
+    std::size_t window_size = 0U;
+};
+
+/**
+ * An input stream over a memory mapped file. The (current window of the) file
+ * is exposed directly as the input buffer, i.e. the parser operates on the
+ * page cache without any intermediate copies.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class mapped_file_input_stream final : public dp::input_buffer
+{
+    detail::posix_file mFile;
+    std::byte *mMapping{nullptr};
+    std::size_t mMappingSize{0U};
+    std::uint64_t mMappingOffset{0U};
+    std::uint64_t mFileSize{0U};
+    mapped_file_options mOptions{};
+
+public:
+    ~mapped_file_input_stream() noexcept;
+    mapped_file_input_stream() noexcept = default;
+
+    mapped_file_input_stream(mapped_file_input_stream const &) = delete;
+    auto operator=(mapped_file_input_stream const &)
+            -> mapped_file_input_stream & = delete;
+
+    mapped_file_input_stream(mapped_file_input_stream &&other) noexcept;
+    auto operator=(mapped_file_input_stream &&other) noexcept
+            -> mapped_file_input_stream &;
+
+    /**
+     * Opens the file for reading and maps the first window (or the whole
+     * file) into memory.
+     */
+    static auto open(std::filesystem::path const &path,
+                     mapped_file_options const &options = {}) noexcept
+            -> result<mapped_file_input_stream>;
+
+    [[nodiscard]] auto file_size() const noexcept -> std::uint64_t
+    {
+        return mFileSize;
+    }
+    /**
+     * The file offset of the next unconsumed byte.
+     */
+    [[nodiscard]] auto position() const noexcept -> std::uint64_t
+    {
+        return mFileSize - input_size();
+    }
+
+private:
+    mapped_file_input_stream(detail::posix_file &&file,
+                             std::uint64_t fileSize,
+                             mapped_file_options const &options) noexcept;
+
+    auto map_window(std::uint64_t position, std::size_t requiredSize) noexcept
+            -> result<void>;
+    auto seek(std::uint64_t position) noexcept -> result<void>;
+    void apply_access_hints() const noexcept;
+    void unmap() noexcept;
+
+    auto do_require_input(size_type requiredSize) noexcept
+            -> result<void> override;
+    auto do_discard_input(size_type amount) noexcept -> result<void> override;
+    auto do_bulk_read(std::byte *dest, std::size_t amount) noexcept
+            -> result<void> override;
+};
+
+} // namespace dplx::dp
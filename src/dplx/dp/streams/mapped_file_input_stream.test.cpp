@@ -0,0 +1,185 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/mapped_file_input_stream.hpp"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/items/skip_item.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "temporary_file.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(std::derived_from<dp::mapped_file_input_stream, dp::input_buffer>);
+static_assert(dp::input_stream<dp::mapped_file_input_stream &>);
+static_assert(std::movable<dp::mapped_file_input_stream>);
+static_assert(!std::copyable<dp::mapped_file_input_stream>);
+
+namespace
+{
+
+auto make_file_content(std::size_t const size) -> std::vector<std::byte>
+{
+    std::vector<std::byte> content(size);
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        content[i] = static_cast<std::byte>(i % 251U);
+    }
+    return content;
+}
+
+} // namespace
+
+TEST_CASE("mapped_file_input_stream should be default constructible")
+{
+    dp::mapped_file_input_stream subject;
+    CHECK(subject.empty());
+    CHECK(subject.input_size() == 0U);
+    CHECK(subject.require_input(1U).error() == dp::errc::end_of_stream);
+}
+
+TEST_CASE("mapped_file_input_stream should fail to open a nonexistent file")
+{
+    temporary_file const file;
+    CHECK(dp::mapped_file_input_stream::open(file.path()).has_failure());
+}
+
+TEST_CASE("mapped_file_input_stream should handle an empty file")
+{
+    temporary_file const file(std::span<std::byte const>{});
+    auto openRx = dp::mapped_file_input_stream::open(file.path());
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    CHECK(subject.empty());
+    CHECK(subject.input_size() == 0U);
+    CHECK(subject.file_size() == 0U);
+    CHECK(subject.require_input(1U).error() == dp::errc::end_of_stream);
+}
+
+TEST_CASE("mapped_file_input_stream maps the whole file by default")
+{
+    constexpr std::size_t fileSize = 3 * 4096U + 17U;
+    auto const content = make_file_content(fileSize);
+    temporary_file const file(content);
+
+    auto openRx = dp::mapped_file_input_stream::open(file.path());
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    CHECK(subject.file_size() == fileSize);
+    CHECK(subject.input_size() == fileSize);
+    CHECK_BLOB_EQ(std::span(subject.data(), subject.size()), content);
+
+    SECTION("and should not be able to require more input")
+    {
+        CHECK(subject.require_input(fileSize + 1U).error()
+              == dp::errc::end_of_stream);
+    }
+    SECTION("and should be movable")
+    {
+        auto const *const mapping = subject.data();
+        dp::mapped_file_input_stream moved(std::move(subject));
+        CHECK(moved.data() == mapping);
+        CHECK(moved.input_size() == fileSize);
+        // NOLINTNEXTLINE(bugprone-use-after-move)
+        CHECK(subject.empty());
+        // NOLINTNEXTLINE(bugprone-use-after-move)
+        CHECK(subject.input_size() == 0U);
+    }
+}
+
+TEST_CASE("mapped_file_input_stream can map the file in windows")
+{
+    constexpr std::size_t fileSize = 5 * 4096U + 17U;
+    auto const content = make_file_content(fileSize);
+    temporary_file const file(content);
+
+    auto openRx = dp::mapped_file_input_stream::open(
+            file.path(), {.access = dp::file_access_pattern::sequential,
+                          .will_need = true,
+                          .huge_pages = true,
+                          .window_size = 1U});
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    REQUIRE(subject.input_size() == fileSize);
+    REQUIRE(subject.size() < fileSize);
+
+    SECTION("and require input across window boundaries")
+    {
+        auto const windowSize = subject.size();
+        subject.discard_buffered(windowSize - 1U);
+        REQUIRE(subject.require_input(dp::minimum_input_buffer_size));
+        CHECK(subject.position() == windowSize - 1U);
+        CHECK_BLOB_EQ(std::span(subject.data(), dp::minimum_input_buffer_size),
+                      std::span(content).subspan(
+                              windowSize - 1U, dp::minimum_input_buffer_size));
+    }
+    SECTION("and discard input beyond the current window")
+    {
+        constexpr std::size_t discardAmount = 3 * 4096U + 5U;
+        REQUIRE(subject.discard_input(discardAmount));
+        CHECK(subject.position() == discardAmount);
+        CHECK(subject.input_size() == fileSize - discardAmount);
+        REQUIRE_FALSE(subject.empty());
+        CHECK(*subject.data() == content[discardAmount]);
+    }
+    SECTION("and bulk read beyond the current window")
+    {
+        std::vector<std::byte> buffer(fileSize - 3U);
+        REQUIRE(subject.bulk_read(buffer.data(), buffer.size()));
+        CHECK_BLOB_EQ(buffer, std::span(content).first(buffer.size()));
+        CHECK(subject.input_size() == 3U);
+        CHECK_BLOB_EQ(std::span(subject.data(), subject.size()),
+                      std::span(content).last(3U));
+    }
+}
+
+TEST_CASE("mapped_file_input_stream can be decoded from")
+{
+    std::vector<int> values(4096U);
+    std::iota(values.begin(), values.end(), 0x10000);
+
+    dp::dynamic_memory_output_stream<> encoded;
+    REQUIRE(dp::encode(encoded, values));
+    temporary_file const file(encoded.written());
+
+    auto const windowSize = GENERATE(std::size_t{0U}, std::size_t{1U});
+    INFO("window size: " << windowSize);
+
+    auto openRx = dp::mapped_file_input_stream::open(
+            file.path(), {.window_size = windowSize});
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    SECTION("with dp::decode")
+    {
+        std::vector<int> decoded;
+        REQUIRE(dp::decode(subject, decoded));
+        CHECK(decoded == values);
+    }
+    SECTION("with skip_item")
+    {
+        dp::parse_context ctx{subject};
+        REQUIRE(dp::skip_item(ctx));
+        CHECK(subject.input_size() == 0U);
+    }
+}
+
+} // namespace dp_tests
@@ -57,6 +57,10 @@ private:
     {
         return errc::end_of_stream;
     }
+    auto do_retained_output() noexcept -> std::span<std::byte> override
+    {
+        return written();
+    }
 };
 
 } // namespace dplx::dp
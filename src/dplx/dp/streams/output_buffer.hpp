@@ -101,7 +101,7 @@ public:
     auto ensure_size(size_type const requestedSize) noexcept -> result<void>
     {
         result<void> rx = outcome::success();
-        if (mOutputBufferSize < requestedSize)
+        if (mOutputBufferSize < requestedSize) [[unlikely]]
         {
             rx = do_grow(requestedSize);
         }
@@ -151,6 +151,27 @@ public:
         return do_sync_output();
     }
 
+    /**
+     * Returns all bytes written so far if the stream keeps them in contiguous
+     * memory and an empty span otherwise. A non-empty span always starts with
+     * the first byte written to the stream and ends at `data()`.
+     */
+    [[nodiscard]] auto retained_output() noexcept -> std::span<std::byte>
+    {
+        return do_retained_output();
+    }
+    /**
+     * Moves the output position back by `numBytes`. The caller must ensure
+     * that `retained_output().size() >= numBytes`.
+     */
+    void uncommit_written(size_type const numBytes) noexcept
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        mOutputBuffer -= numBytes;
+        mOutputBufferSize += numBytes;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
 protected:
     constexpr void reset() noexcept
     {
@@ -178,6 +199,10 @@ private:
     {
         return outcome::success();
     }
+    virtual auto do_retained_output() noexcept -> std::span<std::byte>
+    {
+        return {};
+    }
 };
 
 } // namespace dplx::dp
@@ -0,0 +1,381 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/prefetching_file_input_stream.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <dplx/dp/detail/posix_file.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * The state shared with the read ahead thread. Chunks are identified by their
+ * sequence number since the last restart and stored round robin. The chunks
+ * in [mNumReleased, mNumLoaded) are owned by the consumer, the first one
+ * being the chunk it currently parses.
+ */
+class prefetching_file_input_stream::prefetcher
+{
+    struct chunk_info
+    {
+        std::uint64_t offset;
+        std::size_t size;
+    };
+
+    detail::posix_file mFile;
+    std::uint64_t mFileSize;
+    std::size_t mChunkSize;
+    unsigned mChunkCount;
+    std::unique_ptr<std::byte[]> mStorage;
+    std::unique_ptr<chunk_info[]> mChunks;
+
+    std::mutex mMutex;
+    std::condition_variable mReaderWakeup;
+    std::condition_variable mConsumerWakeup;
+    std::uint64_t mNumLoaded{0U};
+    std::uint64_t mNumReleased{0U};
+    std::uint64_t mReadOffset{0U};
+    std::uint64_t mEpoch{0U};
+    result<void> mReadRx{outcome::success()};
+    bool mFailed{false};
+    bool mBusy{false};
+    bool mStopRequested{false};
+
+    // only accessed by the consumer
+    std::uint64_t mNextChunk{0U};
+
+    std::thread mThread;
+
+public:
+    prefetcher(detail::posix_file &&file,
+               std::uint64_t const fileSize,
+               std::size_t const chunkSize,
+               unsigned const chunkCount)
+        : mFile(std::move(file))
+        , mFileSize(fileSize)
+        , mChunkSize(chunkSize)
+        , mChunkCount(chunkCount)
+        , mStorage(std::make_unique_for_overwrite<std::byte[]>(
+                  (stitch_size + chunkSize) * chunkCount))
+        , mChunks(std::make_unique<chunk_info[]>(chunkCount))
+    {
+    }
+    ~prefetcher() noexcept
+    {
+        if (mThread.joinable())
+        {
+            {
+                std::lock_guard lock(mMutex);
+                mStopRequested = true;
+            }
+            mReaderWakeup.notify_one();
+            mThread.join();
+        }
+    }
+
+    prefetcher(prefetcher const &) = delete;
+    auto operator=(prefetcher const &) -> prefetcher & = delete;
+
+    void start()
+    {
+        mThread = std::thread(&prefetcher::run, this);
+    }
+
+    /**
+     * Waits for the next chunk and prepends it with the `carrySize` bytes
+     * at `carry`.
+     */
+    auto acquire_next(std::byte const *const carry,
+                      std::size_t const carrySize) noexcept
+            -> result<std::span<std::byte const>>
+    {
+        std::unique_lock lock(mMutex);
+        mConsumerWakeup.wait(lock, [this] {
+            return mNextChunk < mNumLoaded || mFailed;
+        });
+        if (mNextChunk >= mNumLoaded)
+        {
+            return take_failure().as_failure();
+        }
+        return expose(carry, carrySize, 0U);
+    }
+
+    /**
+     * Positions the consumer at `target` reusing already loaded chunks if
+     * possible. Otherwise the read ahead is restarted at `target`.
+     */
+    auto seek(std::uint64_t const target) noexcept
+            -> result<std::span<std::byte const>>
+    {
+        std::unique_lock lock(mMutex);
+        if (target >= mFileSize)
+        {
+            restart(lock, mFileSize);
+            return std::span<std::byte const>{};
+        }
+        for (;;)
+        {
+            if (mNextChunk < mNumLoaded)
+            {
+                auto const &chunk = mChunks[mNextChunk % mChunkCount];
+                if (target < chunk.offset + chunk.size)
+                {
+                    return expose(nullptr, 0U,
+                                  static_cast<std::size_t>(target
+                                                           - chunk.offset));
+                }
+                // skip the whole chunk
+                mNextChunk += 1U;
+                mNumReleased = mNextChunk;
+                mReaderWakeup.notify_one();
+                continue;
+            }
+            if (mFailed)
+            {
+                return take_failure().as_failure();
+            }
+            if (target < mReadOffset + mChunkSize)
+            {
+                // the chunk containing target is going to be read next
+                mConsumerWakeup.wait(lock);
+                continue;
+            }
+            restart(lock, target);
+        }
+    }
+
+private:
+    [[nodiscard]] auto chunk_data(std::uint64_t const sequenceNumber) const noexcept
+            -> std::byte *
+    {
+        auto const index
+                = static_cast<std::size_t>(sequenceNumber % mChunkCount);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return mStorage.get() + index * (stitch_size + mChunkSize)
+               + stitch_size;
+    }
+
+    auto expose(std::byte const *const carry,
+                std::size_t const carrySize,
+                std::size_t const skip) noexcept -> std::span<std::byte const>
+    {
+        auto const chunkSize = mChunks[mNextChunk % mChunkCount].size;
+        auto *const chunkData = chunk_data(mNextChunk);
+        if (carrySize > 0U)
+        {
+            // the carried bytes still live in the current chunk which
+            // therefore must not be released beforehand
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy(chunkData - carrySize, carry, carrySize);
+        }
+        mNumReleased = mNextChunk;
+        mNextChunk += 1U;
+        mReaderWakeup.notify_one();
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return std::span<std::byte const>(chunkData - carrySize + skip,
+                                          carrySize + chunkSize - skip);
+    }
+
+    void restart(std::unique_lock<std::mutex> &lock,
+                 std::uint64_t const offset) noexcept
+    {
+        mEpoch += 1U;
+        // the reader must not write into a chunk after we handed it out
+        mConsumerWakeup.wait(lock, [this] { return !mBusy; });
+        mNumLoaded = 0U;
+        mNumReleased = 0U;
+        mNextChunk = 0U;
+        mReadOffset = offset;
+        mReaderWakeup.notify_one();
+    }
+
+    auto take_failure() noexcept -> result<void>
+    {
+        // the first failure is reported verbatim
+        return std::exchange(mReadRx, system_error::errc::io_error);
+    }
+
+    void run() noexcept
+    {
+        std::unique_lock lock(mMutex);
+        for (;;)
+        {
+            mReaderWakeup.wait(lock, [this] {
+                return mStopRequested
+                       || (!mFailed && mReadOffset < mFileSize
+                           && mNumLoaded - mNumReleased < mChunkCount);
+            });
+            if (mStopRequested)
+            {
+                return;
+            }
+
+            auto const sequenceNumber = mNumLoaded;
+            auto const offset = mReadOffset;
+            auto const size = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(mChunkSize, mFileSize - offset));
+            auto const epoch = mEpoch;
+            mBusy = true;
+            lock.unlock();
+
+            auto readRx
+                    = mFile.read_at(chunk_data(sequenceNumber), size, offset);
+
+            lock.lock();
+            mBusy = false;
+            if (epoch == mEpoch)
+            {
+                if (readRx.has_failure())
+                {
+                    mReadRx = std::move(readRx);
+                    mFailed = true;
+                }
+                else
+                {
+                    mChunks[sequenceNumber % mChunkCount]
+                            = chunk_info{offset, size};
+                    mReadOffset = offset + size;
+                    mNumLoaded += 1U;
+                }
+            }
+            mConsumerWakeup.notify_one();
+        }
+    }
+};
+
+prefetching_file_input_stream::~prefetching_file_input_stream() noexcept
+        = default;
+prefetching_file_input_stream::prefetching_file_input_stream() noexcept
+        = default;
+
+prefetching_file_input_stream::prefetching_file_input_stream(
+        prefetching_file_input_stream &&other) noexcept
+    : input_buffer(static_cast<input_buffer &&>(other))
+    , mPrefetcher(std::move(other.mPrefetcher))
+    , mFileSize(std::exchange(other.mFileSize, 0U))
+{
+    other.reset(nullptr, 0U, 0U);
+}
+
+auto prefetching_file_input_stream::operator=(
+        prefetching_file_input_stream &&other) noexcept
+        -> prefetching_file_input_stream &
+{
+    if (this != &other)
+    {
+        input_buffer::operator=(static_cast<input_buffer &&>(other));
+        mPrefetcher = std::move(other.mPrefetcher);
+        mFileSize = std::exchange(other.mFileSize, 0U);
+        other.reset(nullptr, 0U, 0U);
+    }
+    return *this;
+}
+
+prefetching_file_input_stream::prefetching_file_input_stream(
+        std::unique_ptr<prefetcher> &&p, std::uint64_t const fileSize) noexcept
+    : input_buffer(nullptr, 0U, fileSize)
+    , mPrefetcher(std::move(p))
+    , mFileSize(fileSize)
+{
+}
+
+auto prefetching_file_input_stream::open(
+        std::filesystem::path const &path,
+        prefetching_file_options const &options) noexcept
+        -> result<prefetching_file_input_stream>
+{
+    auto const chunkSize = std::max(options.chunk_size, stitch_size);
+    auto const chunkCount = std::max(options.chunk_count, 2U);
+
+    DPLX_TRY(auto &&file,
+             detail::posix_file::open(path, detail::file_open_mode::read));
+    DPLX_TRY(auto const fileSize, file.size());
+
+    std::unique_ptr<prefetcher> p;
+    try
+    {
+        p = std::make_unique<prefetcher>(std::move(file), fileSize, chunkSize,
+                                         chunkCount);
+        p->start();
+    }
+    catch (std::bad_alloc const &)
+    {
+        return system_error::errc::not_enough_memory;
+    }
+    catch (std::system_error const &)
+    {
+        // std::thread failed to launch
+        return system_error::errc::resource_unavailable_try_again;
+    }
+
+    prefetching_file_input_stream stream(std::move(p), fileSize);
+    if (fileSize > 0U)
+    {
+        DPLX_TRY(auto const chunk,
+                 stream.mPrefetcher->acquire_next(nullptr, 0U));
+        stream.reset(chunk.data(), chunk.size(), fileSize);
+    }
+    return stream;
+}
+
+auto prefetching_file_input_stream::do_require_input(
+        size_type const requiredSize) noexcept -> result<void>
+{
+    do
+    {
+        if (size() > stitch_size)
+        {
+            return errc::buffer_size_exceeded;
+        }
+        DPLX_TRY(auto const chunk, mPrefetcher->acquire_next(data(), size()));
+        reset(chunk.data(), chunk.size(), input_size());
+    }
+    while (size() < requiredSize);
+    return outcome::success();
+}
+
+auto prefetching_file_input_stream::do_discard_input(
+        size_type const amount) noexcept -> result<void>
+{
+    // input_buffer::discard_input() already consumed the buffered bytes and
+    // checked the amount against input_size()
+    auto const target = position() + amount;
+    DPLX_TRY(auto const chunk, mPrefetcher->seek(target));
+    reset(chunk.data(), chunk.size(), mFileSize - target);
+    return outcome::success();
+}
+
+auto prefetching_file_input_stream::do_bulk_read(std::byte *dest,
+                                                 std::size_t amount) noexcept
+        -> result<void>
+{
+    do
+    {
+        DPLX_TRY(auto const chunk, mPrefetcher->acquire_next(nullptr, 0U));
+
+        auto const chunkSize = std::min(amount, chunk.size());
+        std::memcpy(dest, chunk.data(), chunkSize);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        dest += chunkSize;
+        amount -= chunkSize;
+        reset(chunk.subspan(chunkSize), input_size() - chunkSize);
+    }
+    while (amount > 0U);
+    return outcome::success();
+}
+
+} // namespace dplx::dp
@@ -0,0 +1,101 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/input_buffer.hpp>
+
+namespace dplx::dp
+{
+
+struct prefetching_file_options
+{
+    /**
+     * The number of bytes read from the file at once.
+     */
+    std::size_t chunk_size = 256U * 1024U;
+    /**
+     * The number of chunks which are read ahead of the parser (including the
+     * one being parsed); at least two are used.
+     */
+    unsigned chunk_count = 4U;
+};
+
+/**
+ * An input stream which reads a file with a background thread staying up to
+ * `chunk_count` chunks ahead of the parser.
+ *
+ * Each chunk is preceded by a small headroom area. If an item head straddles
+ * two chunks, the tail of the current chunk is copied into the headroom of
+ * the next one, so that the parser is again presented with a contiguous
+ * buffer. `require_input()` therefore supports requests up to
+ * `stitch_size` bytes.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class prefetching_file_input_stream final : public dp::input_buffer
+{
+    class prefetcher;
+
+    std::unique_ptr<prefetcher> mPrefetcher;
+    std::uint64_t mFileSize{0U};
+
+public:
+    static constexpr std::size_t stitch_size = 64U;
+    static_assert(stitch_size >= minimum_input_buffer_size);
+
+    ~prefetching_file_input_stream() noexcept;
+    prefetching_file_input_stream() noexcept;
+
+    prefetching_file_input_stream(prefetching_file_input_stream const &)
+            = delete;
+    auto operator=(prefetching_file_input_stream const &)
+            -> prefetching_file_input_stream & = delete;
+
+    prefetching_file_input_stream(
+            prefetching_file_input_stream &&other) noexcept;
+    auto operator=(prefetching_file_input_stream &&other) noexcept
+            -> prefetching_file_input_stream &;
+
+    /**
+     * Opens the file, starts the read ahead thread and waits for the first
+     * chunk.
+     */
+    static auto open(std::filesystem::path const &path,
+                     prefetching_file_options const &options = {}) noexcept
+            -> result<prefetching_file_input_stream>;
+
+    [[nodiscard]] auto file_size() const noexcept -> std::uint64_t
+    {
+        return mFileSize;
+    }
+    /**
+     * The file offset of the next unconsumed byte.
+     */
+    [[nodiscard]] auto position() const noexcept -> std::uint64_t
+    {
+        return mFileSize - input_size();
+    }
+
+private:
+    prefetching_file_input_stream(std::unique_ptr<prefetcher> &&p,
+                                  std::uint64_t fileSize) noexcept;
+
+    auto do_require_input(size_type requiredSize) noexcept
+            -> result<void> override;
+    auto do_discard_input(size_type amount) noexcept -> result<void> override;
+    auto do_bulk_read(std::byte *dest, std::size_t amount) noexcept
+            -> result<void> override;
+};
+
+} // namespace dplx::dp
@@ -0,0 +1,184 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/prefetching_file_input_stream.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/items/skip_item.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "temporary_file.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(std::derived_from<dp::prefetching_file_input_stream,
+                                dp::input_buffer>);
+static_assert(dp::input_stream<dp::prefetching_file_input_stream &>);
+static_assert(std::movable<dp::prefetching_file_input_stream>);
+static_assert(!std::copyable<dp::prefetching_file_input_stream>);
+
+namespace
+{
+
+auto make_file_content(std::size_t const size) -> std::vector<std::byte>
+{
+    std::vector<std::byte> content(size);
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        content[i] = static_cast<std::byte>(i % 251U);
+    }
+    return content;
+}
+
+} // namespace
+
+TEST_CASE("prefetching_file_input_stream should be default constructible")
+{
+    dp::prefetching_file_input_stream subject;
+    CHECK(subject.empty());
+    CHECK(subject.input_size() == 0U);
+    CHECK(subject.require_input(1U).error() == dp::errc::end_of_stream);
+}
+
+TEST_CASE("prefetching_file_input_stream should fail to open a nonexistent "
+          "file")
+{
+    temporary_file const file;
+    CHECK(dp::prefetching_file_input_stream::open(file.path()).has_failure());
+}
+
+TEST_CASE("prefetching_file_input_stream should handle an empty file")
+{
+    temporary_file const file(std::span<std::byte const>{});
+    auto openRx = dp::prefetching_file_input_stream::open(file.path());
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    CHECK(subject.empty());
+    CHECK(subject.input_size() == 0U);
+    CHECK(subject.require_input(1U).error() == dp::errc::end_of_stream);
+}
+
+TEST_CASE("prefetching_file_input_stream reads a file in chunks")
+{
+    constexpr std::size_t chunkSize = 128U;
+    constexpr std::size_t fileSize = 40 * chunkSize + 17U;
+    auto const content = make_file_content(fileSize);
+    temporary_file const file(content);
+
+    auto const chunkCount = GENERATE(2U, 5U);
+    INFO("chunk count: " << chunkCount);
+
+    auto openRx = dp::prefetching_file_input_stream::open(
+            file.path(),
+            {.chunk_size = chunkSize, .chunk_count = chunkCount});
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    REQUIRE(subject.file_size() == fileSize);
+    REQUIRE(subject.input_size() == fileSize);
+    REQUIRE(subject.size() == chunkSize);
+    CHECK_BLOB_EQ(std::span(subject.data(), subject.size()),
+                  std::span(content).first(chunkSize));
+
+    SECTION("and stitches input across chunk boundaries")
+    {
+        subject.discard_buffered(chunkSize - 3U);
+        REQUIRE(subject.require_input(dp::minimum_input_buffer_size));
+        CHECK(subject.position() == chunkSize - 3U);
+        CHECK(subject.size() == chunkSize + 3U);
+        CHECK_BLOB_EQ(std::span(subject.data(), subject.size()),
+                      std::span(content).subspan(chunkSize - 3U,
+                                                 chunkSize + 3U));
+    }
+    SECTION("and rejects requests exceeding the stitch size")
+    {
+        subject.discard_buffered(chunkSize
+                                 - dp::prefetching_file_input_stream::stitch_size
+                                 - 1U);
+        CHECK(subject.require_input(chunkSize).error()
+              == dp::errc::buffer_size_exceeded);
+    }
+    SECTION("and discards input within the read ahead")
+    {
+        constexpr std::size_t discardAmount = chunkSize + 5U;
+        REQUIRE(subject.discard_input(discardAmount));
+        CHECK(subject.position() == discardAmount);
+        REQUIRE_FALSE(subject.empty());
+        CHECK(*subject.data() == content[discardAmount]);
+    }
+    SECTION("and discards input beyond the read ahead")
+    {
+        constexpr std::size_t discardAmount = 31 * chunkSize + 5U;
+        REQUIRE(subject.discard_input(discardAmount));
+        CHECK(subject.position() == discardAmount);
+        CHECK(subject.input_size() == fileSize - discardAmount);
+        REQUIRE_FALSE(subject.empty());
+        CHECK(*subject.data() == content[discardAmount]);
+
+        REQUIRE(subject.discard_input(2 * chunkSize));
+        CHECK(*subject.data() == content[discardAmount + 2 * chunkSize]);
+    }
+    SECTION("and discards all input")
+    {
+        REQUIRE(subject.discard_input(fileSize));
+        CHECK(subject.empty());
+        CHECK(subject.input_size() == 0U);
+    }
+    SECTION("and bulk reads across chunk boundaries")
+    {
+        std::vector<std::byte> buffer(fileSize - 3U);
+        REQUIRE(subject.bulk_read(buffer.data(), buffer.size()));
+        CHECK_BLOB_EQ(buffer, std::span(content).first(buffer.size()));
+        CHECK(subject.input_size() == 3U);
+        CHECK_BLOB_EQ(std::span(subject.data(), subject.size()),
+                      std::span(content).last(3U));
+    }
+}
+
+TEST_CASE("prefetching_file_input_stream can be decoded from")
+{
+    std::vector<int> values(4096U);
+    std::iota(values.begin(), values.end(), 0x10000);
+
+    dp::dynamic_memory_output_stream<> encoded;
+    REQUIRE(dp::encode(encoded, values));
+    temporary_file const file(encoded.written());
+
+    auto const chunkSize = GENERATE(std::size_t{64U}, std::size_t{101U},
+                                    std::size_t{4096U});
+    INFO("chunk size: " << chunkSize);
+
+    auto openRx = dp::prefetching_file_input_stream::open(
+            file.path(), {.chunk_size = chunkSize, .chunk_count = 3U});
+    REQUIRE(openRx);
+    auto subject = std::move(openRx).assume_value();
+
+    SECTION("with dp::decode")
+    {
+        std::vector<int> decoded;
+        REQUIRE(dp::decode(subject, decoded));
+        CHECK(decoded == values);
+    }
+    SECTION("with skip_item")
+    {
+        dp::parse_context ctx{subject};
+        REQUIRE(dp::skip_item(ctx));
+        CHECK(subject.input_size() == 0U);
+    }
+}
+
+} // namespace dp_tests
@@ -0,0 +1,208 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/segmented_input_stream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace dplx::dp
+{
+
+namespace
+{
+
+auto total_size(std::span<std::span<std::byte const> const> const segments)
+        -> std::uint64_t
+{
+    std::uint64_t acc = 0U;
+    for (auto const segment : segments)
+    {
+        acc += segment.size();
+    }
+    return acc;
+}
+
+} // namespace
+
+segmented_input_stream::segmented_input_stream() noexcept
+    : input_buffer(nullptr, 0U, 0U)
+{
+}
+
+segmented_input_stream::segmented_input_stream(
+        segmented_input_stream &&other) noexcept
+    : input_buffer(static_cast<input_buffer &&>(other))
+    , mSegments(std::exchange(other.mSegments, {}))
+    , mNextSegment(std::exchange(other.mNextSegment, 0U))
+    , mNextOffset(std::exchange(other.mNextOffset, 0U))
+{
+    adopt_buffer(other);
+}
+
+auto segmented_input_stream::operator=(segmented_input_stream &&other) noexcept
+        -> segmented_input_stream &
+{
+    if (this != &other)
+    {
+        input_buffer::operator=(static_cast<input_buffer &&>(other));
+        mSegments = std::exchange(other.mSegments, {});
+        mNextSegment = std::exchange(other.mNextSegment, 0U);
+        mNextOffset = std::exchange(other.mNextOffset, 0U);
+        adopt_buffer(other);
+    }
+    return *this;
+}
+
+segmented_input_stream::segmented_input_stream(
+        std::span<std::span<std::byte const> const> const segments) noexcept
+    : input_buffer(nullptr, 0U, total_size(segments))
+    , mSegments(segments)
+{
+    present_next_segment();
+}
+
+void segmented_input_stream::adopt_buffer(
+        segmented_input_stream &other) noexcept
+{
+    mStitching = std::exchange(other.mStitching, false);
+    if (mStitching)
+    {
+        // the buffer points into the stitch buffer of other
+        auto const consumed = static_cast<std::size_t>(
+                other.data() - static_cast<std::byte const *>(
+                        other.mStitchBuffer));
+        std::memcpy(static_cast<std::byte *>(mStitchBuffer),
+                    static_cast<std::byte const *>(other.mStitchBuffer),
+                    stitch_size);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        reset(static_cast<std::byte const *>(mStitchBuffer) + consumed, size(),
+              input_size());
+    }
+    other.reset(nullptr, 0U, 0U);
+}
+
+auto segmented_input_stream::next_chunk() noexcept
+        -> std::span<std::byte const>
+{
+    // skip exhausted and empty segments
+    while (mSegments[mNextSegment].size() == mNextOffset)
+    {
+        mNextSegment += 1U;
+        mNextOffset = 0U;
+    }
+    return mSegments[mNextSegment].subspan(mNextOffset);
+}
+
+void segmented_input_stream::advance(std::uint64_t amount) noexcept
+{
+    while (amount > 0U)
+    {
+        auto const available = mSegments[mNextSegment].size() - mNextOffset;
+        if (amount < available)
+        {
+            mNextOffset += static_cast<std::size_t>(amount);
+            return;
+        }
+        amount -= available;
+        mNextSegment += 1U;
+        mNextOffset = 0U;
+    }
+}
+
+void segmented_input_stream::present_next_segment() noexcept
+{
+    mStitching = false;
+    while (mNextSegment < mSegments.size()
+           && mSegments[mNextSegment].size() == mNextOffset)
+    {
+        mNextSegment += 1U;
+        mNextOffset = 0U;
+    }
+    if (mNextSegment == mSegments.size())
+    {
+        reset(nullptr, 0U, input_size());
+        return;
+    }
+    auto const segment = mSegments[mNextSegment].subspan(mNextOffset);
+    mNextSegment += 1U;
+    mNextOffset = 0U;
+    reset(segment, input_size());
+}
+
+auto segmented_input_stream::do_require_input(
+        size_type const requiredSize) noexcept -> result<void>
+{
+    // input_buffer::require_input() already checked requiredSize against
+    // input_size(), i.e. the segments contain enough bytes
+    if (size() == 0U)
+    {
+        present_next_segment();
+        if (size() >= requiredSize)
+        {
+            return outcome::success();
+        }
+    }
+    if (requiredSize > stitch_size)
+    {
+        return errc::buffer_size_exceeded;
+    }
+
+    // the remaining bytes may already live in the stitch buffer
+    auto const carrySize = size();
+    auto *const stitchBuffer = static_cast<std::byte *>(mStitchBuffer);
+    std::memmove(stitchBuffer, data(), carrySize);
+    auto fillSize = carrySize;
+    while (fillSize < requiredSize)
+    {
+        auto const segment = next_chunk();
+        auto const chunkSize
+                = std::min(requiredSize - fillSize, segment.size());
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(stitchBuffer + fillSize, segment.data(), chunkSize);
+        fillSize += chunkSize;
+        advance(chunkSize);
+    }
+    mStitching = true;
+    reset(stitchBuffer, fillSize, input_size());
+    return outcome::success();
+}
+
+auto segmented_input_stream::do_discard_input(size_type const amount) noexcept
+        -> result<void>
+{
+    // input_buffer::discard_input() already consumed the buffered bytes and
+    // checked the amount against input_size()
+    advance(amount);
+    reset(nullptr, 0U, input_size() - amount);
+    present_next_segment();
+    return outcome::success();
+}
+
+auto segmented_input_stream::do_bulk_read(std::byte *dest,
+                                          std::size_t amount) noexcept
+        -> result<void>
+{
+    // input_buffer::bulk_read() already consumed the buffered bytes and
+    // checked the amount against input_size()
+    auto const remainingInputSize = input_size() - amount;
+    while (amount > 0U)
+    {
+        auto const segment = next_chunk();
+        auto const chunkSize = std::min(amount, segment.size());
+        std::memcpy(dest, segment.data(), chunkSize);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        dest += chunkSize;
+        amount -= chunkSize;
+        advance(chunkSize);
+    }
+    reset(nullptr, 0U, remainingInputSize);
+    present_next_segment();
+    return outcome::success();
+}
+
+} // namespace dplx::dp
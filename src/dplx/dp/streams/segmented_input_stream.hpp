@@ -0,0 +1,75 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/input_buffer.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * An input stream over a list of byte segments, e.g. receive buffers.
+ *
+ * The parser is presented with the segments themselves. Only if
+ * `require_input()` asks for more bytes than remain in the current segment,
+ * the requested bytes are stitched together in a small internal buffer, i.e.
+ * only item heads are ever copied. `bulk_read()` copies straight from the
+ * segments.
+ *
+ * @warning The segment list and the segments must outlive the stream.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class segmented_input_stream final : public dp::input_buffer
+{
+public:
+    static constexpr std::size_t stitch_size = 64U;
+    static_assert(stitch_size >= minimum_input_buffer_size);
+
+private:
+    std::span<std::span<std::byte const> const> mSegments;
+    // the position of the first byte following the current buffer
+    std::size_t mNextSegment{0U};
+    std::size_t mNextOffset{0U};
+    bool mStitching{false};
+    std::byte mStitchBuffer[stitch_size]{};
+
+public:
+    ~segmented_input_stream() noexcept = default;
+    segmented_input_stream() noexcept;
+
+    segmented_input_stream(segmented_input_stream const &) = delete;
+    auto operator=(segmented_input_stream const &)
+            -> segmented_input_stream & = delete;
+
+    segmented_input_stream(segmented_input_stream &&other) noexcept;
+    auto operator=(segmented_input_stream &&other) noexcept
+            -> segmented_input_stream &;
+
+    explicit segmented_input_stream(
+            std::span<std::span<std::byte const> const> segments) noexcept;
+
+private:
+    void adopt_buffer(segmented_input_stream &other) noexcept;
+    auto next_chunk() noexcept -> std::span<std::byte const>;
+    void advance(std::uint64_t amount) noexcept;
+    void present_next_segment() noexcept;
+
+    auto do_require_input(size_type requiredSize) noexcept
+            -> result<void> override;
+    auto do_discard_input(size_type amount) noexcept -> result<void> override;
+    auto do_bulk_read(std::byte *dest, std::size_t amount) noexcept
+            -> result<void> override;
+};
+
+} // namespace dplx::dp
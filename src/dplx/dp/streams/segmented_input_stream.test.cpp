@@ -0,0 +1,156 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/segmented_input_stream.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/items/skip_item.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(std::derived_from<dp::segmented_input_stream, dp::input_buffer>);
+static_assert(dp::input_stream<dp::segmented_input_stream &>);
+static_assert(std::movable<dp::segmented_input_stream>);
+static_assert(!std::copyable<dp::segmented_input_stream>);
+
+namespace
+{
+
+auto split(std::span<std::byte const> const content,
+           std::size_t const segmentSize)
+        -> std::vector<std::span<std::byte const>>
+{
+    std::vector<std::span<std::byte const>> segments;
+    for (std::size_t offset = 0U; offset < content.size();
+         offset += segmentSize)
+    {
+        segments.push_back(content.subspan(
+                offset, std::min(segmentSize, content.size() - offset)));
+        // empty segments must be skipped
+        segments.push_back(content.subspan(0U, 0U));
+    }
+    return segments;
+}
+
+} // namespace
+
+TEST_CASE("segmented_input_stream should be default constructible")
+{
+    dp::segmented_input_stream subject;
+    CHECK(subject.empty());
+    CHECK(subject.input_size() == 0U);
+    CHECK(subject.require_input(1U).error() == dp::errc::end_of_stream);
+}
+
+TEST_CASE("segmented_input_stream should present the segments")
+{
+    std::vector<std::byte> content(10U);
+    for (std::size_t i = 0U; i < content.size(); ++i)
+    {
+        content[i] = static_cast<std::byte>(i);
+    }
+    auto const segments = split(content, 4U);
+
+    dp::segmented_input_stream subject(segments);
+    CHECK(subject.input_size() == content.size());
+    CHECK(subject.data() == content.data());
+    CHECK(subject.size() == 4U);
+
+    SECTION("and stitch small requests")
+    {
+        subject.discard_buffered(3U);
+        REQUIRE(subject.require_input(6U));
+        CHECK(subject.data() != content.data() + 3);
+        REQUIRE(subject.size() == 6U);
+        CHECK(subject.data()[0] == std::byte{3});
+        CHECK(subject.data()[5] == std::byte{8});
+
+        subject.discard_buffered(6U);
+        REQUIRE(subject.require_input(1U));
+        CHECK(subject.data() == content.data() + 9);
+    }
+    SECTION("and reject requests exceeding the stitch buffer")
+    {
+        std::vector<std::byte> large(200U);
+        auto const largeSegments = split(large, 10U);
+        dp::segmented_input_stream largeSubject(largeSegments);
+        CHECK(largeSubject
+                      .require_input(dp::segmented_input_stream::stitch_size
+                                     + 1U)
+                      .error()
+              == dp::errc::buffer_size_exceeded);
+    }
+    SECTION("and read in bulk across segments")
+    {
+        std::vector<std::byte> dest(9U);
+        subject.discard_buffered(1U);
+        REQUIRE(subject.bulk_read(dest.data(), dest.size()));
+        CHECK(dest.front() == std::byte{1});
+        CHECK(dest.back() == std::byte{9});
+        CHECK(subject.input_size() == 0U);
+    }
+    SECTION("and discard across segments")
+    {
+        REQUIRE(subject.discard_input(9U));
+        CHECK(subject.input_size() == 1U);
+        CHECK(subject.data() == content.data() + 9);
+    }
+    SECTION("and be movable while stitching")
+    {
+        subject.discard_buffered(3U);
+        REQUIRE(subject.require_input(6U));
+        subject.discard_buffered(1U);
+
+        dp::segmented_input_stream moved(std::move(subject));
+        REQUIRE(moved.size() == 5U);
+        CHECK(moved.data()[0] == std::byte{4});
+        CHECK(moved.input_size() == 6U);
+    }
+}
+
+TEST_CASE("segmented_input_stream can be decoded from")
+{
+    std::vector<int> values(512U);
+    std::iota(values.begin(), values.end(), 0x7ff0);
+    std::vector<std::vector<std::byte>> const blobs{
+            std::vector<std::byte>(100U, std::byte{0xaa}),
+            std::vector<std::byte>(3U, std::byte{0xbb})};
+
+    dp::dynamic_memory_output_stream<> encoded;
+    REQUIRE(dp::encode(encoded, values));
+    REQUIRE(dp::encode(encoded, blobs));
+    REQUIRE(dp::encode(encoded, values));
+
+    auto const segmentSize = GENERATE(1U, 2U, 7U, 64U, 1000U);
+    INFO(segmentSize);
+    auto const segments = split(encoded.written(), segmentSize);
+
+    dp::segmented_input_stream subject(segments);
+    std::vector<int> decoded;
+    REQUIRE(dp::decode(subject, decoded));
+    CHECK(decoded == values);
+
+    std::vector<std::vector<std::byte>> decodedBlobs;
+    REQUIRE(dp::decode(subject, decodedBlobs));
+    CHECK(decodedBlobs == blobs);
+
+    dp::parse_context ctx{subject};
+    REQUIRE(dp::skip_item(ctx));
+    CHECK(subject.input_size() == 0U);
+}
+
+} // namespace dp_tests
@@ -0,0 +1,206 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/segmented_output_stream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace dplx::dp
+{
+
+segmented_output_stream::segmented_output_stream(
+        segmented_output_stream &&other) noexcept
+    : output_buffer(static_cast<output_buffer &&>(other))
+    , mSegments(std::exchange(other.mSegments, {}))
+    , mTotalSize(std::exchange(other.mTotalSize, 0U))
+    , mWrittenSize(std::exchange(other.mWrittenSize, 0U))
+    , mCursorSegment(std::exchange(other.mCursorSegment, 0U))
+    , mCursorOffset(std::exchange(other.mCursorOffset, 0U))
+    , mBufferSize(std::exchange(other.mBufferSize, 0U))
+{
+    adopt_buffer(other);
+}
+
+auto segmented_output_stream::operator=(
+        segmented_output_stream &&other) noexcept -> segmented_output_stream &
+{
+    if (this != &other)
+    {
+        output_buffer::operator=(static_cast<output_buffer &&>(other));
+        mSegments = std::exchange(other.mSegments, {});
+        mTotalSize = std::exchange(other.mTotalSize, 0U);
+        mWrittenSize = std::exchange(other.mWrittenSize, 0U);
+        mCursorSegment = std::exchange(other.mCursorSegment, 0U);
+        mCursorOffset = std::exchange(other.mCursorOffset, 0U);
+        mBufferSize = std::exchange(other.mBufferSize, 0U);
+        adopt_buffer(other);
+    }
+    return *this;
+}
+
+segmented_output_stream::segmented_output_stream(
+        std::span<std::span<std::byte> const> const segments) noexcept
+    : output_buffer()
+    , mSegments(segments)
+{
+    for (auto const segment : segments)
+    {
+        mTotalSize += segment.size();
+    }
+    (void)present(0U);
+}
+
+void segmented_output_stream::adopt_buffer(
+        segmented_output_stream &other) noexcept
+{
+    mStitching = std::exchange(other.mStitching, false);
+    if (mStitching)
+    {
+        // the buffer points into the stitch buffer of other
+        auto const written = mBufferSize - size();
+        std::memcpy(static_cast<std::byte *>(mStitchBuffer),
+                    static_cast<std::byte const *>(other.mStitchBuffer),
+                    written);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        reset(static_cast<std::byte *>(mStitchBuffer) + written, size());
+    }
+    other.reset();
+}
+
+auto segmented_output_stream::next_chunk() noexcept -> std::span<std::byte>
+{
+    // skip exhausted and empty segments
+    while (mSegments[mCursorSegment].size() == mCursorOffset)
+    {
+        mCursorSegment += 1U;
+        mCursorOffset = 0U;
+    }
+    return mSegments[mCursorSegment].subspan(mCursorOffset);
+}
+
+void segmented_output_stream::advance(std::size_t amount) noexcept
+{
+    while (amount > 0U)
+    {
+        auto const available = mSegments[mCursorSegment].size() - mCursorOffset;
+        if (amount < available)
+        {
+            mCursorOffset += amount;
+            return;
+        }
+        amount -= available;
+        mCursorSegment += 1U;
+        mCursorOffset = 0U;
+    }
+}
+
+void segmented_output_stream::commit_buffer() noexcept
+{
+    auto const written = mBufferSize - size();
+    if (mStitching)
+    {
+        // distribute the stitch buffer content over the segments
+        auto const *src = static_cast<std::byte const *>(mStitchBuffer);
+        auto remaining = written;
+        while (remaining > 0U)
+        {
+            auto const segment = next_chunk();
+            auto const chunkSize = std::min(remaining, segment.size());
+            std::memcpy(segment.data(), src, chunkSize);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            src += chunkSize;
+            remaining -= chunkSize;
+            advance(chunkSize);
+        }
+    }
+    else
+    {
+        advance(written);
+    }
+    mWrittenSize += written;
+    mStitching = false;
+    mBufferSize = 0U;
+    output_buffer::reset();
+}
+
+auto segmented_output_stream::present(size_type const requestedSize) noexcept
+        -> result<void>
+{
+    while (mCursorSegment < mSegments.size()
+           && mSegments[mCursorSegment].size() == mCursorOffset)
+    {
+        mCursorSegment += 1U;
+        mCursorOffset = 0U;
+    }
+    if (mCursorSegment < mSegments.size())
+    {
+        auto const segment = mSegments[mCursorSegment].subspan(mCursorOffset);
+        if (segment.size() >= requestedSize)
+        {
+            mBufferSize = segment.size();
+            output_buffer::reset(segment);
+            return outcome::success();
+        }
+    }
+
+    auto const remainingSize = mTotalSize - mWrittenSize;
+    if (requestedSize > remainingSize)
+    {
+        return errc::end_of_stream;
+    }
+    if (requestedSize > stitch_size)
+    {
+        return errc::buffer_size_exceeded;
+    }
+    // the stitch buffer must not hold more than fits into the segments
+    mBufferSize = static_cast<std::size_t>(
+            std::min<std::uint64_t>(stitch_size, remainingSize));
+    mStitching = true;
+    output_buffer::reset(static_cast<std::byte *>(mStitchBuffer), mBufferSize);
+    return outcome::success();
+}
+
+auto segmented_output_stream::do_grow(size_type const requestedSize) noexcept
+        -> result<void>
+{
+    commit_buffer();
+    return present(requestedSize);
+}
+
+auto segmented_output_stream::do_bulk_write(std::byte const *src,
+                                            std::size_t srcSize) noexcept
+        -> result<void>
+{
+    // output_buffer::bulk_write() has already filled the current buffer
+    commit_buffer();
+    if (srcSize > mTotalSize - mWrittenSize)
+    {
+        (void)present(0U);
+        return errc::end_of_stream;
+    }
+    mWrittenSize += srcSize;
+    while (srcSize > 0U)
+    {
+        auto const segment = next_chunk();
+        auto const chunkSize = std::min(srcSize, segment.size());
+        std::memcpy(segment.data(), src, chunkSize);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        src += chunkSize;
+        srcSize -= chunkSize;
+        advance(chunkSize);
+    }
+    return present(0U);
+}
+
+auto segmented_output_stream::do_sync_output() noexcept -> result<void>
+{
+    commit_buffer();
+    return present(0U);
+}
+
+} // namespace dplx::dp
@@ -0,0 +1,92 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+#include <dplx/dp/streams/output_buffer.hpp>
+
+namespace dplx::dp
+{
+
+/**
+ * An output stream over a list of byte segments, e.g. send buffers.
+ *
+ * The encoder writes directly into the segments. Only if `ensure_size()`
+ * asks for more bytes than remain in the current segment, a small internal
+ * buffer is presented whose content is distributed over the segments
+ * afterwards, i.e. only item heads are ever copied twice. `bulk_write()`
+ * copies straight into the segments.
+ *
+ * The content is only guaranteed to be complete after `sync_output()`.
+ * Writing more than the combined segment size fails with
+ * `errc::end_of_stream`.
+ *
+ * @warning The segment list and the segments must outlive the stream.
+ */
+// the class is final and none of its base classes have public destructors
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class segmented_output_stream final : public output_buffer
+{
+public:
+    static constexpr std::size_t stitch_size = 64U;
+    static_assert(stitch_size >= minimum_output_buffer_size);
+
+private:
+    std::span<std::span<std::byte> const> mSegments;
+    std::uint64_t mTotalSize{0U};
+    // the number of bytes written before the current buffer
+    std::uint64_t mWrittenSize{0U};
+    // the position of the current buffer within the segments
+    std::size_t mCursorSegment{0U};
+    std::size_t mCursorOffset{0U};
+    std::size_t mBufferSize{0U};
+    bool mStitching{false};
+    std::byte mStitchBuffer[stitch_size]{};
+
+public:
+    ~segmented_output_stream() noexcept = default;
+    segmented_output_stream() noexcept = default;
+
+    segmented_output_stream(segmented_output_stream const &) = delete;
+    auto operator=(segmented_output_stream const &)
+            -> segmented_output_stream & = delete;
+
+    segmented_output_stream(segmented_output_stream &&other) noexcept;
+    auto operator=(segmented_output_stream &&other) noexcept
+            -> segmented_output_stream &;
+
+    explicit segmented_output_stream(
+            std::span<std::span<std::byte> const> segments) noexcept;
+
+    /**
+     * The number of bytes written so far, i.e. the prefix of the segments
+     * which is valid after `sync_output()`.
+     */
+    [[nodiscard]] auto written_size() const noexcept -> std::uint64_t
+    {
+        return mWrittenSize + (mBufferSize - size());
+    }
+
+private:
+    void adopt_buffer(segmented_output_stream &other) noexcept;
+    auto next_chunk() noexcept -> std::span<std::byte>;
+    void advance(std::size_t amount) noexcept;
+    void commit_buffer() noexcept;
+    auto present(size_type requestedSize) noexcept -> result<void>;
+
+    auto do_grow(size_type requestedSize) noexcept -> result<void> override;
+    auto do_bulk_write(std::byte const *src, std::size_t srcSize) noexcept
+            -> result<void> override;
+    auto do_sync_output() noexcept -> result<void> override;
+};
+
+} // namespace dplx::dp
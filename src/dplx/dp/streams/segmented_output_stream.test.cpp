@@ -0,0 +1,161 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/streams/segmented_output_stream.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/codecs/core.hpp"
+#include "dplx/dp/codecs/std-container.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+static_assert(
+        std::derived_from<dp::segmented_output_stream, dp::output_buffer>);
+static_assert(dp::output_stream<dp::segmented_output_stream &>);
+static_assert(std::movable<dp::segmented_output_stream>);
+static_assert(!std::copyable<dp::segmented_output_stream>);
+
+namespace
+{
+
+auto split(std::span<std::byte> const content, std::size_t const segmentSize)
+        -> std::vector<std::span<std::byte>>
+{
+    std::vector<std::span<std::byte>> segments;
+    for (std::size_t offset = 0U; offset < content.size();
+         offset += segmentSize)
+    {
+        segments.push_back(content.subspan(
+                offset, std::min(segmentSize, content.size() - offset)));
+        // empty segments must be skipped
+        segments.push_back(content.subspan(0U, 0U));
+    }
+    return segments;
+}
+
+} // namespace
+
+TEST_CASE("segmented_output_stream should be default constructible")
+{
+    dp::segmented_output_stream subject;
+    CHECK(subject.empty());
+    CHECK(subject.written_size() == 0U);
+    CHECK(subject.ensure_size(1U).error() == dp::errc::end_of_stream);
+}
+
+TEST_CASE("segmented_output_stream should present the segments")
+{
+    std::vector<std::byte> content(10U);
+    auto const segments = split(content, 4U);
+
+    dp::segmented_output_stream subject(segments);
+    CHECK(subject.data() == content.data());
+    CHECK(subject.size() == 4U);
+
+    SECTION("and stitch small requests")
+    {
+        subject.commit_written(3U);
+        REQUIRE(subject.ensure_size(6U));
+        CHECK(subject.data() != content.data() + 3);
+        REQUIRE(subject.size() == 7U);
+        for (unsigned i = 0U; i < 6U; ++i)
+        {
+            subject.data()[i] = static_cast<std::byte>(i + 1U);
+        }
+        subject.commit_written(6U);
+        REQUIRE(subject.sync_output());
+        CHECK(subject.written_size() == 9U);
+        CHECK(content[3] == std::byte{1});
+        CHECK(content[8] == std::byte{6});
+        CHECK(content[9] == std::byte{});
+
+        REQUIRE(subject.ensure_size(1U));
+        CHECK(subject.data() == content.data() + 9);
+    }
+    SECTION("and reject requests exceeding the remaining size")
+    {
+        subject.commit_written(3U);
+        CHECK(subject.ensure_size(8U).error() == dp::errc::end_of_stream);
+    }
+    SECTION("and reject requests exceeding the stitch buffer")
+    {
+        std::vector<std::byte> large(200U);
+        auto const largeSegments = split(large, 10U);
+        dp::segmented_output_stream largeSubject(largeSegments);
+        CHECK(largeSubject
+                      .ensure_size(dp::segmented_output_stream::stitch_size
+                                   + 1U)
+                      .error()
+              == dp::errc::buffer_size_exceeded);
+    }
+    SECTION("and write in bulk across segments")
+    {
+        std::vector<std::byte> src(9U, std::byte{0xaa});
+        subject.commit_written(1U);
+        REQUIRE(subject.bulk_write(src));
+        REQUIRE(subject.sync_output());
+        CHECK(subject.written_size() == 10U);
+        CHECK(content[0] == std::byte{});
+        CHECK(content[1] == std::byte{0xaa});
+        CHECK(content[9] == std::byte{0xaa});
+
+        CHECK(subject.bulk_write(src).error() == dp::errc::end_of_stream);
+    }
+    SECTION("and be movable while stitching")
+    {
+        subject.commit_written(3U);
+        REQUIRE(subject.ensure_size(6U));
+        subject.data()[0] = std::byte{0xbb};
+        subject.commit_written(1U);
+
+        dp::segmented_output_stream moved(std::move(subject));
+        moved.data()[0] = std::byte{0xcc};
+        moved.commit_written(1U);
+        REQUIRE(moved.sync_output());
+        CHECK(moved.written_size() == 5U);
+        CHECK(content[3] == std::byte{0xbb});
+        CHECK(content[4] == std::byte{0xcc});
+    }
+}
+
+TEST_CASE("segmented_output_stream can be encoded to")
+{
+    std::vector<int> values(512U);
+    std::iota(values.begin(), values.end(), 0x7ff0);
+    std::vector<std::vector<std::byte>> const blobs{
+            std::vector<std::byte>(100U, std::byte{0xaa}),
+            std::vector<std::byte>(3U, std::byte{0xbb})};
+
+    dp::dynamic_memory_output_stream<> expected;
+    REQUIRE(dp::encode(expected, values));
+    REQUIRE(dp::encode(expected, blobs));
+
+    auto const segmentSize = GENERATE(1U, 2U, 7U, 64U, 1000U);
+    INFO(segmentSize);
+    std::vector<std::byte> content(expected.written().size());
+    auto const segments = split(content, segmentSize);
+
+    dp::segmented_output_stream subject(segments);
+    REQUIRE(dp::encode(subject, values));
+    REQUIRE(dp::encode(subject, blobs));
+    REQUIRE(subject.sync_output());
+
+    CHECK(subject.written_size() == content.size());
+    auto const expectedBytes = expected.written();
+    CHECK_BLOB_EQ(content, expectedBytes);
+}
+
+} // namespace dp_tests
@@ -0,0 +1,668 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/value.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include <dplx/dp/items/emit_context.hpp>
+#include <dplx/dp/items/emit_core.hpp>
+#include <dplx/dp/items/encoded_item_head_size.hpp>
+#include <dplx/dp/items/parse_context.hpp>
+#include <dplx/dp/items/parse_core.hpp>
+#include <dplx/dp/items/parse_ranges.hpp>
+
+namespace dplx::dp
+{
+
+auto value::as_boolean() const noexcept -> result<bool>
+{
+    if (mKind != value_kind::boolean)
+    {
+        return errc::item_type_mismatch;
+    }
+    return mNumber != 0U;
+}
+
+auto value::as_int64() const noexcept -> result<std::int64_t>
+{
+    if (mKind != value_kind::integer)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (mNumber > static_cast<std::uint64_t>(INT64_MAX))
+    {
+        return errc::item_value_out_of_range;
+    }
+    auto const magnitude = static_cast<std::int64_t>(mNumber);
+    return mNegative ? -1 - magnitude : magnitude;
+}
+
+auto value::as_uint64() const noexcept -> result<std::uint64_t>
+{
+    if (mKind != value_kind::integer)
+    {
+        return errc::item_type_mismatch;
+    }
+    if (mNegative)
+    {
+        return errc::item_value_out_of_range;
+    }
+    return mNumber;
+}
+
+auto value::integer_magnitude() const noexcept -> result<std::uint64_t>
+{
+    if (mKind != value_kind::integer)
+    {
+        return errc::item_type_mismatch;
+    }
+    return mNumber;
+}
+
+auto value::as_floating_point() const noexcept -> result<double>
+{
+    if (mKind != value_kind::floating_point)
+    {
+        return errc::item_type_mismatch;
+    }
+    return std::bit_cast<double>(mNumber);
+}
+
+auto value::as_text() const noexcept -> result<std::u8string_view>
+{
+    if (mKind != value_kind::text)
+    {
+        return errc::item_type_mismatch;
+    }
+    return std::u8string_view(static_cast<char8_t const *>(mData),
+                              static_cast<std::size_t>(mNumber));
+}
+
+auto value::as_binary() const noexcept -> result<std::span<std::byte const>>
+{
+    if (mKind != value_kind::binary)
+    {
+        return errc::item_type_mismatch;
+    }
+    return std::span<std::byte const>(static_cast<std::byte const *>(mData),
+                                      static_cast<std::size_t>(mNumber));
+}
+
+auto value::simple_value() const noexcept -> result<std::uint8_t>
+{
+    if (mKind != value_kind::simple)
+    {
+        return errc::item_type_mismatch;
+    }
+    return static_cast<std::uint8_t>(mNumber);
+}
+
+auto value::elements() const noexcept -> std::span<value const>
+{
+    if (mKind != value_kind::array)
+    {
+        return {};
+    }
+    return {static_cast<value const *>(mData),
+            static_cast<std::size_t>(mNumber)};
+}
+
+auto value::entries() const noexcept -> std::span<value_map_entry const>
+{
+    if (mKind != value_kind::map)
+    {
+        return {};
+    }
+    return {static_cast<value_map_entry const *>(mData),
+            static_cast<std::size_t>(mNumber)};
+}
+
+auto value::find(std::u8string_view const key) const noexcept
+        -> value const *
+{
+    for (auto const &entry : entries())
+    {
+        if (auto const candidate = entry.key.as_text();
+            candidate.has_value() && candidate.assume_value() == key)
+        {
+            return &entry.mapped;
+        }
+    }
+    return nullptr;
+}
+
+auto value::tag_number() const noexcept -> result<std::uint64_t>
+{
+    if (mKind != value_kind::tag)
+    {
+        return errc::item_type_mismatch;
+    }
+    return mNumber;
+}
+
+auto value::tagged() const noexcept -> result<value const *>
+{
+    if (mKind != value_kind::tag)
+    {
+        return errc::item_type_mismatch;
+    }
+    return static_cast<value const *>(mData);
+}
+
+namespace
+{
+
+using value_allocator = std::pmr::polymorphic_allocator<std::byte>;
+
+template <typename T>
+auto allocate_nodes(value_allocator alloc, std::size_t const n) -> T *
+{
+    T *const nodes = alloc.allocate_object<T>(n);
+    std::uninitialized_default_construct_n(nodes, n);
+    return nodes;
+}
+
+struct open_container
+{
+    // the container value which is completed by a break
+    value *target;
+    value *elements;
+    value_map_entry *entries;
+    // the number of subitems of a definite container (map keys and values
+    // count separately)
+    std::uint64_t numSubitems;
+    std::uint64_t numParsed;
+    bool map;
+    bool indefinite;
+    // the subitems of an indefinite container parsed so far
+    std::vector<value> pending;
+
+    [[nodiscard]] auto next_slot() noexcept -> value *
+    {
+        auto const i = numParsed++;
+        if (!map)
+        {
+            return &elements[i];
+        }
+        auto &entry = entries[i / 2U];
+        return (i & 1U) == 0U ? &entry.key : &entry.mapped;
+    }
+};
+
+auto parse_string(parse_context &ctx,
+                  item_head const &head,
+                  value_strings const strings,
+                  value_allocator const &alloc) -> result<value>
+{
+    std::byte const *content = nullptr;
+    std::size_t size = 0U;
+    if (!head.indefinite())
+    {
+        if (ctx.in.input_size() < head.value)
+        {
+            // defend against amplification attacks exhausting main memory
+            return errc::missing_data;
+        }
+        size = static_cast<std::size_t>(head.value);
+        // the buffer of a stream which isn't resident is refilled, i.e. an
+        // alias would dangle
+        if (strings == value_strings::alias_input
+            && detail::input_is_resident(ctx.in))
+        {
+            content = ctx.in.data();
+            ctx.in.discard_buffered(size);
+        }
+        else if (size != 0U)
+        {
+            auto *const buffer = allocate_nodes<std::byte>(alloc, size);
+            DPLX_TRY(ctx.in.bulk_read(buffer, size));
+            content = buffer;
+        }
+        DPLX_TRY(detail::validate_blob(ctx, head.type, content, size));
+    }
+    else
+    {
+        std::vector<std::byte> concatenated;
+        for (;;)
+        {
+            DPLX_TRY(item_head const &chunk, dp::parse_item_head(ctx));
+            if (chunk.is_special_break())
+            {
+                break;
+            }
+            if (chunk.type != head.type || chunk.indefinite())
+            {
+                return errc::invalid_indefinite_subitem;
+            }
+            if (ctx.in.input_size() < chunk.value)
+            {
+                return errc::missing_data;
+            }
+            auto const offset = concatenated.size();
+            concatenated.resize(offset + static_cast<std::size_t>(chunk.value));
+            DPLX_TRY(ctx.in.bulk_read(concatenated.data() + offset,
+                                      static_cast<std::size_t>(chunk.value)));
+            DPLX_TRY(detail::validate_blob(
+                    ctx, head.type, concatenated.data() + offset,
+                    static_cast<std::size_t>(chunk.value)));
+        }
+        size = concatenated.size();
+        if (size != 0U)
+        {
+            auto *const buffer = allocate_nodes<std::byte>(alloc, size);
+            std::memcpy(buffer, concatenated.data(), size);
+            content = buffer;
+        }
+    }
+
+    if (head.type == type_code::text)
+    {
+        return value::make_text(std::u8string_view(
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                reinterpret_cast<char8_t const *>(content), size));
+    }
+    return value::make_binary(std::span<std::byte const>(content, size));
+}
+
+auto parse_special(item_head const &head) noexcept -> result<value>
+{
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+    switch (head.encoded_length)
+    {
+    case 1U + sizeof(std::uint64_t):
+        return value::make_floating_point(std::bit_cast<double>(head.value));
+    case 1U + sizeof(std::uint32_t):
+        return value::make_floating_point(std::bit_cast<float>(
+                static_cast<std::uint32_t>(head.value)));
+    case 1U + sizeof(std::uint16_t):
+        return value::make_floating_point(
+                detail::load_iec559_half(static_cast<unsigned>(head.value)));
+    default:
+        break;
+    }
+    switch (head.value)
+    {
+    case 20U:
+    case 21U:
+        return value::make_boolean(head.value == 21U);
+    case 22U:
+        return value::make_null();
+    case 23U:
+        return value::make_undefined();
+    default:
+        return value::make_simple(static_cast<std::uint8_t>(head.value));
+    }
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+auto parse_value(parse_context &ctx,
+                 value &outValue,
+                 value_strings const strings) noexcept -> result<void>
+{
+    constexpr std::size_t numStackItems = 16;
+
+    auto const alloc = ctx.get_allocator();
+    boost::container::small_vector<open_container, numStackItems> stack;
+    try
+    {
+        // the value to be parsed next or nullptr within indefinite containers
+        value *slot = &outValue;
+        for (;;)
+        {
+            DPLX_TRY(item_head const &head, dp::parse_item_head(ctx));
+
+            if (slot == nullptr)
+            {
+                auto &top = stack.back();
+                if (head.is_special_break())
+                {
+                    auto const numParsed = top.pending.size();
+                    if (!top.map)
+                    {
+                        auto *const elements
+                                = allocate_nodes<value>(alloc, numParsed);
+                        std::ranges::copy(top.pending, elements);
+                        *top.target = value::make_array(
+                                std::span<value const>(elements, numParsed));
+                    }
+                    else
+                    {
+                        if ((numParsed & 1U) != 0U)
+                        {
+                            return errc::item_type_mismatch;
+                        }
+                        auto *const entries = allocate_nodes<value_map_entry>(
+                                alloc, numParsed / 2U);
+                        for (std::size_t i = 0U; i < numParsed / 2U; ++i)
+                        {
+                            entries[i] = {top.pending[2U * i],
+                                          top.pending[2U * i + 1U]};
+                        }
+                        *top.target = value::make_map(
+                                std::span<value_map_entry const>(
+                                        entries, numParsed / 2U));
+                    }
+                    stack.pop_back();
+                }
+                else
+                {
+                    slot = &top.pending.emplace_back();
+                }
+            }
+
+            if (slot != nullptr)
+            {
+                switch (head.type)
+                {
+                case type_code::posint:
+                    *slot = value::make_unsigned(head.value);
+                    break;
+                case type_code::negint:
+                    *slot = value::make_negative(head.value);
+                    break;
+
+                case type_code::binary:
+                case type_code::text:
+                {
+                    DPLX_TRY(*slot, parse_string(ctx, head, strings, alloc));
+                    break;
+                }
+
+                case type_code::array:
+                case type_code::map:
+                {
+                    bool const isMap = head.type == type_code::map;
+                    if (head.indefinite())
+                    {
+                        stack.push_back(open_container{
+                                .target = slot,
+                                .elements = nullptr,
+                                .entries = nullptr,
+                                .numSubitems = 0U,
+                                .numParsed = 0U,
+                                .map = isMap,
+                                .indefinite = true,
+                                .pending = {},
+                        });
+                        break;
+                    }
+                    if ((ctx.in.input_size() >> (isMap ? 1 : 0)) < head.value)
+                    {
+                        // defend against amplification attacks exhausting
+                        // main memory
+                        return errc::missing_data;
+                    }
+                    auto const size = static_cast<std::size_t>(head.value);
+                    open_container container{
+                            .target = slot,
+                            .elements = nullptr,
+                            .entries = nullptr,
+                            .numSubitems = isMap ? head.value * 2U : head.value,
+                            .numParsed = 0U,
+                            .map = isMap,
+                            .indefinite = false,
+                            .pending = {},
+                    };
+                    if (isMap)
+                    {
+                        container.entries
+                                = allocate_nodes<value_map_entry>(alloc, size);
+                        *slot = value::make_map(
+                                std::span<value_map_entry const>(
+                                        container.entries, size));
+                    }
+                    else
+                    {
+                        container.elements = allocate_nodes<value>(alloc, size);
+                        *slot = value::make_array(std::span<value const>(
+                                container.elements, size));
+                    }
+                    if (size != 0U)
+                    {
+                        stack.push_back(std::move(container));
+                    }
+                    break;
+                }
+
+                case type_code::tag:
+                {
+                    auto *const tagged = allocate_nodes<value>(alloc, 1U);
+                    *slot = value::make_tag(head.value, *tagged);
+                    stack.push_back(open_container{
+                            .target = slot,
+                            .elements = tagged,
+                            .entries = nullptr,
+                            .numSubitems = 1U,
+                            .numParsed = 0U,
+                            .map = false,
+                            .indefinite = false,
+                            .pending = {},
+                    });
+                    break;
+                }
+
+                case type_code::special:
+                {
+                    if (head.is_special_break())
+                    {
+                        return errc::item_type_mismatch;
+                    }
+                    DPLX_TRY(*slot, parse_special(head));
+                    break;
+                }
+
+                default:
+                    return errc::invalid_additional_information;
+                }
+            }
+
+            // determine the next slot and close completed containers
+            for (;;)
+            {
+                if (stack.empty())
+                {
+                    return outcome::success();
+                }
+                auto &top = stack.back();
+                if (top.indefinite)
+                {
+                    slot = nullptr;
+                    break;
+                }
+                if (top.numParsed < top.numSubitems)
+                {
+                    slot = top.next_slot();
+                    break;
+                }
+                stack.pop_back();
+            }
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+}
+
+auto parse_value(input_buffer &in,
+                 std::pmr::monotonic_buffer_resource &arena,
+                 value &outValue,
+                 value_strings const strings) noexcept -> result<void>
+{
+    parse_context ctx{in, &arena};
+    return dp::parse_value(ctx, outValue, strings);
+}
+
+namespace
+{
+
+// visits the value and its subitems in encoding order
+template <typename Fn>
+auto visit_preorder(value const &root, Fn &&fn) noexcept -> result<void>
+{
+    constexpr std::size_t numStackItems = 32;
+
+    try
+    {
+        boost::container::small_vector<value const *, numStackItems> pending;
+        pending.push_back(&root);
+        while (!pending.empty())
+        {
+            value const &v = *pending.back();
+            pending.pop_back();
+            DPLX_TRY(fn(v));
+
+            switch (v.kind())
+            {
+            case value_kind::array:
+            {
+                auto const elements = v.elements();
+                for (auto it = elements.rbegin(); it != elements.rend(); ++it)
+                {
+                    pending.push_back(&*it);
+                }
+                break;
+            }
+            case value_kind::map:
+            {
+                auto const entries = v.entries();
+                for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+                {
+                    pending.push_back(&it->mapped);
+                    pending.push_back(&it->key);
+                }
+                break;
+            }
+            case value_kind::tag:
+                pending.push_back(v.tagged().assume_value());
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        return errc::not_enough_memory;
+    }
+    return outcome::success();
+}
+
+auto encode_node(emit_context &ctx, value const &v) noexcept -> result<void>
+{
+    switch (v.kind())
+    {
+    case value_kind::null:
+        return dp::emit_null(ctx);
+    case value_kind::undefined:
+        return dp::emit_undefined(ctx);
+    case value_kind::boolean:
+        return dp::emit_boolean(ctx, v.as_boolean().assume_value());
+    case value_kind::integer:
+        return detail::store_var_uint(
+                ctx.out, v.integer_magnitude().assume_value(),
+                v.is_negative() ? type_code::negint : type_code::posint);
+    case value_kind::floating_point:
+        return dp::emit_float_double(ctx,
+                                     v.as_floating_point().assume_value());
+    case value_kind::text:
+    {
+        auto const text = v.as_text().assume_value();
+        return dp::emit_u8string(ctx, text.data(), text.size());
+    }
+    case value_kind::binary:
+    {
+        auto const bytes = v.as_binary().assume_value();
+        return dp::emit_binary(ctx, bytes.data(), bytes.size());
+    }
+    case value_kind::array:
+        return dp::emit_array(ctx, v.size());
+    case value_kind::map:
+        return dp::emit_map(ctx, v.size());
+    case value_kind::tag:
+        return dp::emit_tag(ctx, v.tag_number().assume_value());
+    case value_kind::simple:
+        return detail::store_var_uint(
+                ctx.out, static_cast<unsigned>(v.simple_value().assume_value()),
+                type_code::special);
+    }
+    return errc::bad;
+}
+
+auto size_of_node(value const &v) noexcept -> std::uint64_t
+{
+    switch (v.kind())
+    {
+    case value_kind::null:
+    case value_kind::undefined:
+    case value_kind::boolean:
+        return 1U;
+    case value_kind::integer:
+        return dp::encoded_item_head_size(
+                v.is_negative() ? type_code::negint : type_code::posint,
+                v.integer_magnitude().assume_value());
+    case value_kind::floating_point:
+        return 1U + sizeof(double);
+    case value_kind::text:
+        return dp::encoded_item_head_size(type_code::text, v.size())
+               + v.size();
+    case value_kind::binary:
+        return dp::encoded_item_head_size(type_code::binary, v.size())
+               + v.size();
+    case value_kind::array:
+        return dp::encoded_item_head_size(type_code::array, v.size());
+    case value_kind::map:
+        return dp::encoded_item_head_size(type_code::map, v.size());
+    case value_kind::tag:
+        return dp::encoded_item_head_size(type_code::tag,
+                                          v.tag_number().assume_value());
+    case value_kind::simple:
+        return dp::encoded_item_head_size(type_code::special,
+                                          v.simple_value().assume_value());
+    }
+    return 0U;
+}
+
+} // namespace
+
+
+auto codec<value>::encode(emit_context &ctx, value const &v) noexcept
+        -> result<void>
+{
+    return visit_preorder(
+            v, [&ctx](value const &node) { return encode_node(ctx, node); });
+}
+
+auto codec<value>::size_of(emit_context &, value const &v) noexcept
+        -> std::uint64_t
+{
+    std::uint64_t size = 0U;
+    if (visit_preorder(v,
+                       [&size](value const &node) noexcept -> result<void> {
+                           size += size_of_node(node);
+                           return outcome::success();
+                       })
+                .has_failure())
+    {
+        // the traversal stack couldn't be allocated; the encoder will fail
+        // for the same reason
+        return UINT64_MAX;
+    }
+    return size;
+}
+
+} // namespace dplx::dp
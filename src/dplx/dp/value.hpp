@@ -0,0 +1,283 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include <dplx/dp/disappointment.hpp>
+#include <dplx/dp/fwd.hpp>
+
+namespace dplx::dp
+{
+
+enum class value_kind : std::uint8_t
+{
+    null,
+    undefined,
+    boolean,
+    integer,
+    floating_point,
+    text,
+    binary,
+    array,
+    map,
+    tag,
+    simple,
+};
+
+struct value_map_entry;
+
+/**
+ * A schema-less CBOR item.
+ *
+ * A `value` never owns any memory, i.e. it is trivially copyable and
+ * trivially destructible. Strings and subitems are referenced by pointer; the
+ * referenced memory must outlive the value. `parse_value()` allocates all of
+ * them from the allocator of the `parse_context` which should therefore be
+ * backed by a `std::pmr::monotonic_buffer_resource`: a document is released
+ * as a whole by releasing the arena, no destructors need to be run.
+ */
+class value
+{
+    value_kind mKind{value_kind::null};
+    bool mNegative{false};
+    // the integer magnitude, the boolean, the floating point bits, the string
+    // byte size, the number of elements or map entries, the tag number or the
+    // simple value
+    std::uint64_t mNumber{0U};
+    void const *mData{nullptr};
+
+    constexpr value(value_kind const kind,
+                    std::uint64_t const number,
+                    void const *const data = nullptr) noexcept
+        : mKind(kind)
+        , mNumber(number)
+        , mData(data)
+    {
+    }
+
+public:
+    constexpr value() noexcept = default;
+
+    static constexpr auto make_null() noexcept -> value
+    {
+        return value{};
+    }
+    static constexpr auto make_undefined() noexcept -> value
+    {
+        return value{value_kind::undefined, 0U};
+    }
+    static constexpr auto make_boolean(bool const b) noexcept -> value
+    {
+        return value{value_kind::boolean, b ? 1U : 0U};
+    }
+    static constexpr auto make_integer(std::int64_t const i) noexcept -> value
+    {
+        return i < 0 ? make_negative(static_cast<std::uint64_t>(-(i + 1)))
+                     : make_unsigned(static_cast<std::uint64_t>(i));
+    }
+    static constexpr auto make_unsigned(std::uint64_t const u) noexcept
+            -> value
+    {
+        return value{value_kind::integer, u};
+    }
+    /**
+     * Creates the negative integer `-1 - magnitude`, i.e. the whole CBOR
+     * negint range can be represented.
+     */
+    static constexpr auto make_negative(std::uint64_t const magnitude) noexcept
+            -> value
+    {
+        value v{value_kind::integer, magnitude};
+        v.mNegative = true;
+        return v;
+    }
+    static constexpr auto make_floating_point(double const d) noexcept -> value
+    {
+        return value{value_kind::floating_point,
+                     std::bit_cast<std::uint64_t>(d)};
+    }
+    static constexpr auto make_text(std::u8string_view const text) noexcept
+            -> value
+    {
+        return value{value_kind::text, text.size(), text.data()};
+    }
+    static constexpr auto
+    make_binary(std::span<std::byte const> const bytes) noexcept -> value
+    {
+        return value{value_kind::binary, bytes.size(), bytes.data()};
+    }
+    static constexpr auto
+    make_array(std::span<value const> const elements) noexcept -> value
+    {
+        return value{value_kind::array, elements.size(), elements.data()};
+    }
+    static auto make_map(std::span<value_map_entry const> entries) noexcept
+            -> value;
+    static constexpr auto make_tag(std::uint64_t const number,
+                                   value const &tagged) noexcept -> value
+    {
+        return value{value_kind::tag, number, &tagged};
+    }
+    static constexpr auto make_simple(std::uint8_t const simpleValue) noexcept
+            -> value
+    {
+        return value{value_kind::simple, simpleValue};
+    }
+
+    [[nodiscard]] constexpr auto kind() const noexcept -> value_kind
+    {
+        return mKind;
+    }
+    [[nodiscard]] constexpr auto is_null() const noexcept -> bool
+    {
+        return mKind == value_kind::null;
+    }
+    /**
+     * Returns true for integers below zero.
+     */
+    [[nodiscard]] constexpr auto is_negative() const noexcept -> bool
+    {
+        return mNegative;
+    }
+    /**
+     * Returns the number of bytes, elements or map entries of a string,
+     * array or map respectively and zero otherwise.
+     */
+    [[nodiscard]] constexpr auto size() const noexcept -> std::uint64_t
+    {
+        switch (mKind)
+        {
+        case value_kind::text:
+        case value_kind::binary:
+        case value_kind::array:
+        case value_kind::map:
+            return mNumber;
+        default:
+            return 0U;
+        }
+    }
+
+    [[nodiscard]] auto as_boolean() const noexcept -> result<bool>;
+    /**
+     * Fails with `errc::item_value_out_of_range` if the integer doesn't fit.
+     */
+    [[nodiscard]] auto as_int64() const noexcept -> result<std::int64_t>;
+    /**
+     * Fails with `errc::item_value_out_of_range` for negative integers.
+     */
+    [[nodiscard]] auto as_uint64() const noexcept -> result<std::uint64_t>;
+    /**
+     * Returns the magnitude of an integer, i.e. `-1 - value` if it is
+     * negative.
+     */
+    [[nodiscard]] auto integer_magnitude() const noexcept
+            -> result<std::uint64_t>;
+    [[nodiscard]] auto as_floating_point() const noexcept -> result<double>;
+    [[nodiscard]] auto as_text() const noexcept -> result<std::u8string_view>;
+    [[nodiscard]] auto as_binary() const noexcept
+            -> result<std::span<std::byte const>>;
+    [[nodiscard]] auto simple_value() const noexcept -> result<std::uint8_t>;
+
+    /**
+     * Returns the elements of an array or an empty span.
+     */
+    [[nodiscard]] auto elements() const noexcept -> std::span<value const>;
+    /**
+     * Returns the entries of a map in encoding order or an empty span.
+     */
+    [[nodiscard]] auto entries() const noexcept
+            -> std::span<value_map_entry const>;
+    /**
+     * Returns the value of the first map entry whose key is a text equal to
+     * `key` or `nullptr` if there is none.
+     */
+    [[nodiscard]] auto find(std::u8string_view key) const noexcept
+            -> value const *;
+
+    [[nodiscard]] auto tag_number() const noexcept -> result<std::uint64_t>;
+    /**
+     * Returns the item enclosed by a tag.
+     */
+    [[nodiscard]] auto tagged() const noexcept -> result<value const *>;
+};
+static_assert(std::is_trivially_copyable_v<value>);
+static_assert(std::is_trivially_destructible_v<value>);
+
+struct value_map_entry
+{
+    value key;
+    value mapped;
+};
+
+inline auto
+value::make_map(std::span<value_map_entry const> const entries) noexcept
+        -> value
+{
+    return value{value_kind::map, entries.size(), entries.data()};
+}
+
+/**
+ * Controls whether `parse_value()` copies string contents into the arena.
+ */
+enum class value_strings : std::uint8_t
+{
+    copy,
+    /// strings reference the input buffer which must outlive the value if
+    /// the whole input is resident (e.g. a `memory_input_stream`), otherwise
+    /// they are copied
+    alias_input,
+};
+
+/**
+ * Parses the next item into a `value`.
+ *
+ * The item is parsed with an explicit stack instead of recursion, i.e.
+ * deeply nested items cannot overflow the call stack. All subitems, strings
+ * and indefinite string concatenations are allocated from
+ * `ctx.get_allocator()` and never deallocated, see `value`.
+ */
+auto parse_value(parse_context &ctx,
+                 value &outValue,
+                 value_strings strings = value_strings::copy) noexcept
+        -> result<void>;
+/**
+ * Parses the next item of `in` into a `value` whose nodes are allocated from
+ * `arena`, i.e. the value is valid as long as the arena.
+ */
+auto parse_value(input_buffer &in,
+                 std::pmr::monotonic_buffer_resource &arena,
+                 value &outValue,
+                 value_strings strings = value_strings::copy) noexcept
+        -> result<void>;
+
+/**
+ * Only encodes values. Decoding requires an arena which outlives the value,
+ * therefore it is provided by `parse_value()` instead of `dp::decode()`
+ * whose default allocator would leak the nodes.
+ */
+template <>
+class codec<value>
+{
+public:
+    /**
+     * Encodes the value with definite lengths and floating point numbers as
+     * double precision.
+     */
+    static auto encode(emit_context &ctx, value const &v) noexcept
+            -> result<void>;
+    static auto size_of(emit_context &ctx, value const &v) noexcept
+            -> std::uint64_t;
+};
+
+} // namespace dplx::dp
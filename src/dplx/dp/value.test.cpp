@@ -0,0 +1,218 @@
+// Copyright Henrik Steffen Gaßmann 2023
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dplx/dp/value.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "blob_matcher.hpp"
+#include "dplx/dp/api.hpp"
+#include "dplx/dp/items/parse_context.hpp"
+#include "dplx/dp/streams/dynamic_memory_output_stream.hpp"
+#include "dplx/dp/streams/memory_input_stream.hpp"
+#include "dplx/dp/streams/segmented_input_stream.hpp"
+#include "test_utils.hpp"
+
+namespace dp_tests
+{
+
+TEST_CASE("parse_value should build a DOM")
+{
+    // {"a": [1, -2, h'0203', [_ 4]], "bc": (_ "d", "e"), 5: 1(1.5)}
+    std::array const encoded{
+            std::byte{0xa3}, std::byte{0x61}, std::byte{0x61},
+            std::byte{0x84}, std::byte{0x01}, std::byte{0x21},
+            std::byte{0x42}, std::byte{0x02}, std::byte{0x03},
+            std::byte{0x9f}, std::byte{0x04}, std::byte{0xff},
+            std::byte{0x62}, std::byte{0x62}, std::byte{0x63},
+            std::byte{0x7f}, std::byte{0x61}, std::byte{0x64},
+            std::byte{0x61}, std::byte{0x65}, std::byte{0xff},
+            std::byte{0x05}, std::byte{0xc1}, std::byte{0xf9},
+            std::byte{0x3e}, std::byte{0x00}};
+
+    std::pmr::monotonic_buffer_resource arena;
+    dp::memory_input_stream in(encoded);
+    dp::parse_context ctx{in, &arena};
+
+    auto const strings = GENERATE(dp::value_strings::copy,
+                                  dp::value_strings::alias_input);
+    INFO(static_cast<int>(strings));
+
+    dp::value subject;
+    REQUIRE(dp::parse_value(ctx, subject, strings));
+    CHECK(in.empty());
+
+    REQUIRE(subject.kind() == dp::value_kind::map);
+    CHECK(subject.size() == 3U);
+
+    auto const *a = subject.find(u8"a");
+    REQUIRE(a != nullptr);
+    auto const elements = a->elements();
+    REQUIRE(elements.size() == 4U);
+    CHECK(elements[0].as_int64().value() == 1);
+    CHECK(elements[1].as_int64().value() == -2);
+    CHECK(elements[1].as_uint64().error() == dp::errc::item_value_out_of_range);
+    auto const binary = elements[2].as_binary().value();
+    CHECK(binary.size() == 2U);
+    CHECK(binary[1] == std::byte{0x03});
+    CHECK((binary.data() == encoded.data() + 7)
+          == (strings == dp::value_strings::alias_input));
+    REQUIRE(elements[3].elements().size() == 1U);
+    CHECK(elements[3].elements()[0].as_uint64().value() == 4U);
+
+    auto const *bc = subject.find(u8"bc");
+    REQUIRE(bc != nullptr);
+    CHECK(bc->as_text().value() == u8"de");
+
+    auto const &last = subject.entries()[2];
+    CHECK(last.key.as_uint64().value() == 5U);
+    CHECK(last.mapped.tag_number().value() == 1U);
+    CHECK(last.mapped.tagged().value()->as_floating_point().value() == 1.5);
+
+    CHECK(subject.find(u8"x") == nullptr);
+    CHECK(subject.as_text().error() == dp::errc::item_type_mismatch);
+}
+
+TEST_CASE("parse_value should not alias input which isn't resident")
+{
+    // ["ab", "cd"]
+    std::array const encoded{std::byte{0x82}, std::byte{0x62},
+                             std::byte{0x61}, std::byte{0x62},
+                             std::byte{0x62}, std::byte{0x63},
+                             std::byte{0x64}};
+    std::array const segments{std::span<std::byte const>(encoded).first(4U),
+                              std::span<std::byte const>(encoded).subspan(4U)};
+
+    std::pmr::monotonic_buffer_resource arena;
+    dp::segmented_input_stream in(segments);
+    dp::parse_context ctx{in, &arena};
+
+    dp::value subject;
+    REQUIRE(dp::parse_value(ctx, subject, dp::value_strings::alias_input));
+
+    auto const elements = subject.elements();
+    REQUIRE(elements.size() == 2U);
+    CHECK(elements[0].as_text().value() == u8"ab");
+    CHECK(elements[1].as_text().value() == u8"cd");
+    auto const *const first = static_cast<void const *>(
+            elements[0].as_text().value().data());
+    CHECK(first != static_cast<void const *>(encoded.data() + 2));
+}
+
+// decoding requires an arena, see parse_value()
+static_assert(!dp::decodable<dp::value>);
+static_assert(dp::encodable<dp::value>);
+
+TEST_CASE("parse_value should allocate from the given arena")
+{
+    // [1, "ab"]
+    std::array const encoded{std::byte{0x82}, std::byte{0x01},
+                             std::byte{0x62}, std::byte{0x61},
+                             std::byte{0x62}};
+    dp::memory_input_stream in(encoded);
+    std::pmr::monotonic_buffer_resource arena;
+
+    dp::value subject;
+    REQUIRE(dp::parse_value(in, arena, subject));
+
+    auto const elements = subject.elements();
+    REQUIRE(elements.size() == 2U);
+    CHECK(elements[0].as_uint64().value() == 1U);
+    CHECK(elements[1].as_text().value() == u8"ab");
+}
+
+TEST_CASE("parse_value should not recurse")
+{
+    constexpr std::size_t depth = 100'000;
+    std::vector<std::byte> encoded(depth, std::byte{0x81});
+    encoded.push_back(std::byte{0xf6});
+
+    std::pmr::monotonic_buffer_resource arena;
+    dp::memory_input_stream in(encoded);
+    dp::parse_context ctx{in, &arena};
+
+    dp::value subject;
+    REQUIRE(dp::parse_value(ctx, subject));
+
+    dp::value const *it = &subject;
+    for (std::size_t i = 0U; i < depth; ++i)
+    {
+        REQUIRE(it->kind() == dp::value_kind::array);
+        it = it->elements().data();
+    }
+    CHECK(it->is_null());
+
+    dp::dynamic_memory_output_stream<> out;
+    REQUIRE(dp::encode(out, subject));
+    auto const reencoded = std::span<std::byte const>(out.written());
+    CHECK(reencoded.size() == encoded.size());
+    CHECK(std::ranges::equal(reencoded, encoded));
+}
+
+TEST_CASE("parse_value should reject malformed items")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    dp::value subject;
+
+    SECTION("a top level break")
+    {
+        std::array const encoded{std::byte{0xff}};
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in, &arena};
+        CHECK(dp::parse_value(ctx, subject).error()
+              == dp::errc::item_type_mismatch);
+    }
+    SECTION("an indefinite map with a missing value")
+    {
+        std::array const encoded{std::byte{0xbf}, std::byte{0x01},
+                                 std::byte{0xff}};
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in, &arena};
+        CHECK(dp::parse_value(ctx, subject).error()
+              == dp::errc::item_type_mismatch);
+    }
+    SECTION("an oversized array")
+    {
+        std::array const encoded{std::byte{0x9a}, std::byte{0xff},
+                                 std::byte{0xff}, std::byte{0xff},
+                                 std::byte{0xff}};
+        dp::memory_input_stream in(encoded);
+        dp::parse_context ctx{in, &arena};
+        CHECK(dp::parse_value(ctx, subject).error() == dp::errc::missing_data);
+    }
+}
+
+TEST_CASE("value should be encodable")
+{
+    std::array const elements{dp::value::make_integer(-1),
+                              dp::value::make_text(u8"ab"),
+                              dp::value::make_boolean(true)};
+    std::array const entries{dp::value_map_entry{
+            dp::value::make_unsigned(1U),
+            dp::value::make_array(elements),
+    }};
+    auto const subject = dp::value::make_map(entries);
+
+    std::array const expected{std::byte{0xa1}, std::byte{0x01},
+                              std::byte{0x83}, std::byte{0x20},
+                              std::byte{0x62}, std::byte{0x61},
+                              std::byte{0x62}, std::byte{0xf5}};
+
+    CHECK(dp::encoded_size_of(subject) == expected.size());
+
+    dp::dynamic_memory_output_stream<> out;
+    REQUIRE(dp::encode(out, subject));
+    auto const written = std::span<std::byte const>(out.written());
+    CHECK_BLOB_EQ(written, expected);
+}
+
+} // namespace dp_tests